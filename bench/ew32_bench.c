@@ -0,0 +1,460 @@
+// EasyWIN32 benchmarks
+// Runs headless (no window is needed on non-Win32 platforms) and prints one line per case.
+// Usage: ew32_bench [--quick] [--out results.json]
+
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+
+#ifdef EW32_BENCH_RAYCASTER
+#   define DOOM_NO_MAIN
+#   include "../doom.c"
+#else
+#   include "../easyWIN32.h"
+#endif
+
+#define BENCH_MAX_RESULTS 256
+
+typedef struct BenchResult {
+    char name[64];
+    uint width, height, walls;
+    uint64 iterations;
+    double nsPerOp;
+    double nsPerPixel; // 0 if the case does not work on pixels
+    double framesPerSecond; // 0 if the case is not a full frame
+} bench_result;
+
+typedef void (func_BENCH)(void* data);
+
+static bench_result RESULTS[BENCH_MAX_RESULTS];
+static uint NB_RESULTS = 0;
+static double MIN_BENCH_TIME = 0.25; // Seconds spent on each case
+
+/// @brief Time a case and record its result
+/// @param opsPerCall Number of operations done by one call of "fn"
+/// @param pixelsPerCall Number of pixels touched by one call of "fn" (0 if not relevant)
+/// @param isFrame Wether each operation of "fn" renders a whole frame
+static void benchRun(const char* name, uint width, uint height, uint walls, uint64 opsPerCall, uint64 pixelsPerCall, bool isFrame, func_BENCH* fn, void* data) {
+    for (uint i = 0; i < 3; ++i) fn(data); // Warmup
+
+    uint64 calls = 0, batch = 1;
+    uint64 start = EW32_profileNow(), elapsed = 0;
+    while (elapsed < MIN_BENCH_TIME * 1e9) {
+        for (uint64 i = 0; i < batch; ++i) fn(data);
+        calls += batch;
+        elapsed = EW32_profileNow() - start;
+        if (batch < (1u << 20)) batch *= 2;
+    }
+
+    bench_result* result = RESULTS + NB_RESULTS++;
+    *result = (bench_result){ .width = width, .height = height, .walls = walls, .iterations = calls };
+    snprintf(result->name, sizeof(result->name), "%s", name);
+    result->nsPerOp = (double)elapsed / (calls * opsPerCall);
+    result->nsPerPixel = pixelsPerCall ? (double)elapsed / (calls * pixelsPerCall) : 0.0;
+    result->framesPerSecond = isFrame ? calls * opsPerCall * 1e9 / elapsed : 0.0; // Each op is a frame
+
+    printf("%-20s %5ux%-5u walls=%-4u %12.3f ns/op", result->name, width, height, walls, result->nsPerOp);
+    if (pixelsPerCall) printf(" %9.3f ns/px", result->nsPerPixel);
+    if (isFrame) printf(" %10.1f fps", result->framesPerSecond);
+    printf("\n");
+}
+
+static bool benchWriteResults(const char* path) {
+    FILE* file = fopen(path, "w");
+    if (!file) {
+        fprintf(stderr, "[EasyWIN32] Failed to open '%s' for writing!\n", path);
+        return false;
+    }
+
+    fprintf(file, "{\"results\":[");
+    for (uint i = 0; i < NB_RESULTS; ++i) {
+        bench_result* r = RESULTS + i;
+        fprintf(file, "%s\n{\"name\":\"%s\",\"width\":%u,\"height\":%u,\"walls\":%u,\"iterations\":%llu,\"ns_per_op\":%.4f,\"ns_per_pixel\":%.4f,\"fps\":%.2f}",
+            i ? "," : "", r->name, r->width, r->height, r->walls, (unsigned long long)r->iterations, r->nsPerOp, r->nsPerPixel, r->framesPerSecond);
+    }
+    fprintf(file, "\n]}\n");
+
+    return fclose(file) == 0;
+}
+
+static const struct { uint width, height; } RESOLUTIONS[] = { {200, 150}, {640, 480}, {1280, 720} };
+#define NB_RESOLUTIONS (sizeof(RESOLUTIONS) / sizeof(RESOLUTIONS[0]))
+
+static ew32_texture benchTexture(uint width, uint height, uint bitDepth) {
+    return (ew32_texture){ .width = width, .height = height, .bitDepth = bitDepth, .buffer = malloc(bitDepth / 8 * width * height) };
+}
+
+
+
+///// TEXTURE
+
+static void benchFill(void* data) {
+    ew32_texture* tex = data;
+    EW32_pixelPipelineGet(EW32_FORMAT_RGB32, EW32_FILTER_NEAREST, EW32_BLEND_COPY)->fill(tex->buffer, tex->width * tex->height, EW32_PACK_RGB(32, 64, 128));
+}
+
+// Upscale to a 1080p window, as done by the present (ns/px are counted on the window pixels)
+typedef struct BenchScale { ew32_texture* src; ew32_texture dst; const ew32_pixel_pipeline* pipeline; } bench_scale;
+static void benchScale(void* data) {
+    bench_scale* s = data;
+    s->pipeline->scale(&s->dst, s->src, 0);
+}
+
+// Palette expansion of an 8 bits texture, as done by the present
+typedef struct BenchExpand { ew32_texture indexed; uint32* dst; uint32 palette[EW32_PALETTE_SIZE]; } bench_expand;
+static void benchExpandIndexed(void* data) {
+    bench_expand* e = data;
+    EW32_textureExpandIndexed(e->dst, e->indexed.buffer, e->indexed.width * e->indexed.height, e->palette);
+}
+
+///// INPUT
+
+static const ew32_key BENCH_KEYS[] = { 'Z', 'Q', 'S', 'D', 'K', 'M', EW32_KEY_SHIFT, EW32_KEY_ESCAPE, EW32_KEY_SPACE, EW32_KEY_ARROW_UP, EW32_KEY_ARROW_DOWN, EW32_KEY_ARROW_LEFT, EW32_KEY_ARROW_RIGHT, EW32_KEY_CTRL, 'A', 'E' };
+#define NB_BENCH_KEYS (sizeof(BENCH_KEYS) / sizeof(BENCH_KEYS[0]))
+
+static void benchInputUpdate(void* data) {
+    uint* frame = data;
+    for (uint i = 0; i < 8; ++i) EW32_inputSimulateKey(BENCH_KEYS[(*frame + i) % NB_BENCH_KEYS], (*frame + i) & 1);
+    EW32_StartFrame();
+
+    uint count = 0;
+    for (uint i = 0; i < NB_BENCH_KEYS; ++i) count += EW32_inputIsKeyDown(BENCH_KEYS[i]) + EW32_inputIsKeyReleased(BENCH_KEYS[i]);
+    *frame += 1 + (count & 1);
+}
+
+// Same as "benchInputUpdate", but bindings are resolved once and polled from a snapshot
+static int BENCH_KEY_INDICES[NB_BENCH_KEYS];
+static void benchInputSnapshot(void* data) {
+    uint* frame = data;
+    for (uint i = 0; i < 8; ++i) EW32_inputSimulateKey(BENCH_KEYS[(*frame + i) % NB_BENCH_KEYS], (*frame + i) & 1);
+    EW32_StartFrame();
+
+    ew32_input_snapshot snapshot = EW32_inputGetSnapshot();
+    uint count = 0;
+    for (uint i = 0; i < NB_BENCH_KEYS; ++i) count += EW32_keySetHas(&snapshot.down, BENCH_KEY_INDICES[i]) + EW32_keySetHas(&snapshot.released, BENCH_KEY_INDICES[i]);
+    *frame += 1 + (count & 1);
+}
+
+
+
+///// CONTEXTS
+
+#define BENCH_MAX_THREADS 4
+#define BENCH_FRAMES_PER_THREAD 32
+
+// Each thread renders frames on its own headless context (fill + present of an 8 bits backbuffer).
+// The threads live for a whole case: each sample releases them with a barrier, so thread creation is not timed.
+typedef struct BenchContexts {
+    ew32_context* contexts[BENCH_MAX_THREADS];
+    uint nbThreads;
+    pthread_t threads[BENCH_MAX_THREADS];
+    struct BenchContextWorker { struct BenchContexts* b; uint index; } workers[BENCH_MAX_THREADS];
+    pthread_barrier_t start, done; // Shared by the workers and the timing thread
+    bool quit;
+} bench_contexts;
+static void* benchContextThread(void* data) {
+    struct BenchContextWorker* worker = data;
+    bench_contexts* b = worker->b;
+    ew32_context* context = b->contexts[worker->index];
+    ew32_texture* tex = EW32_textureGetCtx(context);
+    const ew32_pixel_pipeline* pipeline = EW32_pixelPipelineGet(EW32_FORMAT_INDEXED8, EW32_FILTER_NEAREST, EW32_BLEND_COPY);
+    while (true) {
+        pthread_barrier_wait(&b->start);
+        if (b->quit) {
+            EW32_PROFILE_THREAD_RELEASE(); // Profiled frames allocated a ring, the next case reuses it
+            return NULL;
+        }
+        for (uint i = 0; i < BENCH_FRAMES_PER_THREAD; ++i) {
+            EW32_StartFrameCtx(context);
+            pipeline->fill(tex->buffer, tex->width * tex->height, (uint8)(EW32_timeFrameCountCtx(context) + i));
+            EW32_EndFrameCtx(context);
+        }
+        pthread_barrier_wait(&b->done);
+    }
+}
+static void benchContextsStart(bench_contexts* b, uint nbThreads) {
+    b->nbThreads = nbThreads;
+    b->quit = false;
+    pthread_barrier_init(&b->start, NULL, nbThreads + 1);
+    pthread_barrier_init(&b->done, NULL, nbThreads + 1);
+    for (uint i = 0; i < nbThreads; ++i) {
+        b->workers[i] = (struct BenchContextWorker){ .b = b, .index = i };
+        pthread_create(b->threads + i, NULL, benchContextThread, b->workers + i);
+    }
+}
+static void benchContextsStop(bench_contexts* b) {
+    b->quit = true;
+    pthread_barrier_wait(&b->start);
+    for (uint i = 0; i < b->nbThreads; ++i) pthread_join(b->threads[i], NULL);
+    pthread_barrier_destroy(&b->start);
+    pthread_barrier_destroy(&b->done);
+}
+// Cost of a frame woken up by a redraw request in idle mode (the wait itself never blocks)
+static void benchIdleRequest(void* data) {
+    ew32_context* context = data;
+    EW32_RequestRedrawCtx(context);
+    EW32_StartFrameCtx(context);
+    EW32_EndFrameCtx(context);
+}
+static void benchContexts(void* data) {
+    bench_contexts* b = data;
+    pthread_barrier_wait(&b->start);
+    pthread_barrier_wait(&b->done);
+}
+
+
+
+#ifdef EW32_BENCH_RAYCASTER
+///// RAYCASTER
+
+static char BENCH_TEXTURE_PATH[1024]; // Temporary texture asset file, in the system temporary directory
+
+// Place a temporary file in the system temporary directory
+static void benchTempPath(char* path, uint size, const char* name) {
+    const char* dir = getenv("TMPDIR");
+    if (!dir || !*dir) dir = getenv("TEMP");
+    if (!dir || !*dir) dir = getenv("TMP");
+#ifdef _WIN32
+    if (!dir || !*dir) dir = ".";
+#else
+    if (!dir || !*dir) dir = "/tmp";
+#endif
+    snprintf(path, size, "%s/%s", dir, name);
+}
+
+static uint32 benchRandomState = 0x12345678;
+static float benchRandom() { // Deterministic LCG so that every run renders the same scenes
+    benchRandomState = benchRandomState * 1664525u + 1013904223u;
+    return (benchRandomState >> 8) / (float)(1u << 24);
+}
+
+static void benchClear(void* data) { (void)data; clear(); }
+
+static volatile uint32 benchSink;
+static void benchToValue(void* data) {
+    (void)data;
+    uint32 acc = 0;
+    for (uint i = 0; i < 4096; ++i) acc ^= toValue(i * (1.0f / 4096.0f));
+    benchSink = acc;
+}
+
+typedef struct BenchScene {
+    wall* walls;
+    uint nbWalls;
+    material materials[2];
+    vec2 rays[256];
+    float viewWidth;
+} bench_scene;
+
+static void benchSceneGenerate(bench_scene* scene, uint nbWalls) {
+    benchRandomState = 0x12345678 + nbWalls;
+    scene->materials[0] = (material){ .type = 0, .color = 0.5 };
+    scene->materials[1] = (material){ .type = 1, .texture = 0 };
+    scene->nbWalls = nbWalls;
+    scene->walls = malloc(sizeof(wall) * nbWalls);
+    for (uint i = 0; i < nbWalls; ++i) {
+        vec2 p = Vec2(benchRandom() * 40 - 20, benchRandom() * 40 - 20);
+        float a = benchRandom() * TAU, l = 1 + benchRandom() * 4;
+        scene->walls[i] = (wall){ .p1 = p, .p2 = addS2(p, Vec2(cos(a), sin(a)), l), .floor = 0.0, .height = 1 + benchRandom() * 4, .mat = scene->materials + (i & 1) };
+    }
+    for (uint i = 0; i < 256; ++i) {
+        float a = benchRandom() * TAU;
+        scene->rays[i] = Vec2(cos(a), sin(a));
+    }
+    scene->viewWidth = tan(FOV * 0.5) * NCP;
+}
+
+static void benchWallDist(void* data) {
+    bench_scene* scene = data;
+    float acc = 0;
+    for (uint i = 0; i < 256; ++i) {
+        float d = wallDist(vec2_zero, scene->rays[i], scene->walls + (i % scene->nbWalls));
+        if (d < FLOAT_MAX) acc += d;
+    }
+    benchSink = (uint32)acc;
+}
+
+static void benchSceneRender(void* data) {
+    bench_scene* scene = data;
+    sceneRender(scene->walls, scene->nbWalls, Vec2(0.5, 0.25), Vec2(0, 1), scene->viewWidth);
+}
+
+// Walls then sprites, most of them hidden behind walls or out of view
+typedef struct BenchSprites { bench_scene scene; sprite* sprites; uint nbSprites; } bench_sprites;
+static void benchSpritesRender(void* data) {
+    bench_sprites* b = data;
+    sceneRender(b->scene.walls, b->scene.nbWalls, Vec2(0.5, 0.25), Vec2(0, 1), b->scene.viewWidth);
+    spritesRender(b->sprites, b->nbSprites, Vec2(0.5, 0.25), Vec2(0, 1), b->scene.viewWidth);
+}
+
+// A map with more texture data than the cache budget: every wall has its own texture and the view turns each frame
+#define BENCH_STREAM_TEXTURES 256
+#define BENCH_STREAM_SIZE 64
+#define BENCH_STREAM_BUDGET (32 * 1024)
+typedef struct BenchStream { bench_scene scene; material* materials; float angle; } bench_stream;
+static void benchSceneStream(void* data) {
+    bench_stream* stream = data;
+    stream->angle += 0.05;
+    sceneRender(stream->scene.walls, stream->scene.nbWalls, Vec2(0.5, 0.25), Vec2(cos(stream->angle), sin(stream->angle)), stream->scene.viewWidth);
+}
+static bool benchStreamAssetWrite(const char* path) {
+    ew32_texture textures[BENCH_STREAM_TEXTURES];
+    for (uint i = 0; i < BENCH_STREAM_TEXTURES; ++i) {
+        textures[i] = benchTexture(BENCH_STREAM_SIZE, BENCH_STREAM_SIZE, 8);
+        for (uint j = 0; j < BENCH_STREAM_SIZE * BENCH_STREAM_SIZE; ++j) textures[i].buffer[j] = (uint8)(i * 31 + j * 7 + (j >> 6));
+    }
+    bool written = EW32_textureAssetWrite(path, textures, BENCH_STREAM_TEXTURES, true);
+    for (uint i = 0; i < BENCH_STREAM_TEXTURES; ++i) free(textures[i].buffer);
+    return written;
+}
+#endif
+
+
+
+int main(int argc, char** argv) {
+    const char* outPath = "bench_results.json";
+    for (int i = 1; i < argc; ++i) {
+        if (!strcmp(argv[i], "--quick")) MIN_BENCH_TIME = 0.02;
+        else if (!strcmp(argv[i], "--out") && i + 1 < argc) outPath = argv[++i];
+        else {
+            fprintf(stderr, "Usage: %s [--quick] [--out results.json]\n", argv[0]);
+            return 1;
+        }
+    }
+
+    ew32_init_params params = EW32_GetDefaultInitParams();
+    params.width = 64; params.height = 64;
+    EW32_Initilize("EasyWIN32 benchmark", params);
+
+#ifdef EW32_BENCH_RAYCASTER
+    paletteInit();
+    benchTempPath(BENCH_TEXTURE_PATH, sizeof(BENCH_TEXTURE_PATH), "ew32_bench_textures.ew32t");
+    TEXTURE_CACHE = texturesLoad(BENCH_TEXTURE_PATH, 1 << 20);
+    if (!TEXTURE_CACHE) {
+        remove(BENCH_TEXTURE_PATH);
+        return 1;
+    }
+#endif
+
+    ew32_texture window = benchTexture(1920, 1080, 32);
+    for (uint r = 0; r < NB_RESOLUTIONS; ++r) {
+        ew32_texture tex = benchTexture(RESOLUTIONS[r].width, RESOLUTIONS[r].height, 32);
+        uint64 pixels = (uint64)tex.width * tex.height;
+
+        benchRun("fill", tex.width, tex.height, 0, 1, pixels, false, benchFill, &tex);
+        bench_scale scale = { .src = &tex, .dst = window, .pipeline = EW32_pixelPipelineGet(EW32_FORMAT_RGB32, EW32_FILTER_NEAREST, EW32_BLEND_COPY) };
+        benchRun("scale_nearest", tex.width, tex.height, 0, 1, (uint64)window.width * window.height, false, benchScale, &scale);
+        scale.pipeline = EW32_pixelPipelineGet(EW32_FORMAT_RGB32, EW32_FILTER_BILINEAR, EW32_BLEND_COPY);
+        benchRun("scale_bilinear", tex.width, tex.height, 0, 1, (uint64)window.width * window.height, false, benchScale, &scale);
+
+        bench_expand expand = { .indexed = benchTexture(tex.width, tex.height, 8), .dst = (uint32*)tex.buffer };
+        for (uint i = 0; i < EW32_PALETTE_SIZE; ++i) expand.palette[i] = EW32_PACK_RGB(i, 255 - i, i / 2);
+        for (uint64 i = 0; i < pixels; ++i) expand.indexed.buffer[i] = (uint8)(i * 7 + i / 13);
+        benchRun("expand_indexed", tex.width, tex.height, 0, 1, pixels, false, benchExpandIndexed, &expand);
+
+#ifdef EW32_BENCH_RAYCASTER
+        static const uint WALL_COUNTS[] = { 4, 32, 128 };
+        ew32_texture* targets[] = { &expand.indexed, &tex };
+        for (uint t = 0; t < 2; ++t) {
+            renderSetTarget(*targets[t]);
+            bool indexed = targets[t]->bitDepth == 8;
+            benchRun(indexed ? "clear" : "clear_rgb32", tex.width, tex.height, 0, 1, pixels, false, benchClear, NULL);
+
+            for (uint w = 0; w < sizeof(WALL_COUNTS) / sizeof(WALL_COUNTS[0]); ++w) {
+                bench_scene scene;
+                benchSceneGenerate(&scene, WALL_COUNTS[w]);
+                benchRun(indexed ? "scene_render" : "scene_render_rgb32", tex.width, tex.height, scene.nbWalls, 1, pixels, true, benchSceneRender, &scene);
+                free(scene.walls);
+            }
+        }
+#endif
+        free(expand.indexed.buffer);
+        free(tex.buffer);
+    }
+    free(window.buffer);
+
+#ifdef EW32_BENCH_RAYCASTER
+    benchRun("to_value", 0, 0, 0, 4096, 0, false, benchToValue, NULL);
+
+    bench_scene scene;
+    benchSceneGenerate(&scene, 64);
+    benchRun("wall_dist", 0, 0, scene.nbWalls, 256, 0, false, benchWallDist, &scene);
+    free(scene.walls);
+
+    static const uint SPRITE_COUNTS[] = { 256, 1024, 4096 };
+    ew32_texture spriteTarget = benchTexture(640, 480, 8);
+    renderSetTarget(spriteTarget);
+    for (uint n = 0; n < sizeof(SPRITE_COUNTS) / sizeof(SPRITE_COUNTS[0]); ++n) {
+        bench_sprites sprites = { .nbSprites = SPRITE_COUNTS[n] };
+        benchSceneGenerate(&sprites.scene, 32);
+        sprites.sprites = malloc(sizeof(sprite) * sprites.nbSprites);
+        for (uint i = 0; i < sprites.nbSprites; ++i) {
+            sprites.sprites[i] = (sprite){ .pos = Vec2(benchRandom() * 40 - 20, benchRandom() * 40 - 20), .height = 0.5 + benchRandom() * 1.5, .width = 0.5 + benchRandom(), .texture = 2 };
+        }
+        char name[32];
+        snprintf(name, sizeof(name), "sprites_x%u", sprites.nbSprites);
+        benchRun(name, spriteTarget.width, spriteTarget.height, sprites.scene.nbWalls, 1, (uint64)spriteTarget.width * spriteTarget.height, true, benchSpritesRender, &sprites);
+        free(sprites.sprites);
+        free(sprites.scene.walls);
+    }
+    free(spriteTarget.buffer);
+
+    EW32_textureCacheDestroy(TEXTURE_CACHE);
+    if (!benchStreamAssetWrite(BENCH_TEXTURE_PATH) || !(TEXTURE_CACHE = EW32_textureCacheCreate(BENCH_TEXTURE_PATH, BENCH_STREAM_BUDGET))) {
+        remove(BENCH_TEXTURE_PATH);
+        return 1;
+    }
+    bench_stream stream = {0};
+    benchSceneGenerate(&stream.scene, 128);
+    stream.materials = malloc(sizeof(material) * stream.scene.nbWalls);
+    for (uint i = 0; i < stream.scene.nbWalls; ++i) {
+        stream.materials[i] = (material){ .type = 1, .texture = i % BENCH_STREAM_TEXTURES };
+        stream.scene.walls[i].mat = stream.materials + i;
+    }
+    ew32_texture target = benchTexture(640, 480, 8);
+    renderSetTarget(target);
+    benchRun("scene_stream", target.width, target.height, stream.scene.nbWalls, 1, (uint64)target.width * target.height, true, benchSceneStream, &stream);
+
+    ew32_texture_cache_stats stats = EW32_textureCacheGetStats(TEXTURE_CACHE);
+    printf("%-20s hits=%llu misses=%llu loads=%llu evictions=%llu resident=%llu/%llu bytes\n", "  texture_cache",
+        (unsigned long long)stats.hits, (unsigned long long)stats.misses, (unsigned long long)stats.loads, (unsigned long long)stats.evictions,
+        (unsigned long long)stats.residentBytes, (unsigned long long)stats.budgetBytes);
+    free(target.buffer);
+    free(stream.materials);
+    free(stream.scene.walls);
+    EW32_textureCacheDestroy(TEXTURE_CACHE);
+    remove(BENCH_TEXTURE_PATH);
+    renderShutdown();
+#endif
+
+    uint frame = 0;
+    benchRun("input_update", 0, 0, 0, 1, 0, true, benchInputUpdate, &frame);
+    for (uint i = 0; i < NB_BENCH_KEYS; ++i) BENCH_KEY_INDICES[i] = EW32_inputKeyIndex(BENCH_KEYS[i]);
+    benchRun("input_snapshot", 0, 0, 0, 1, 0, true, benchInputSnapshot, &frame);
+
+    ew32_init_params contextParams = EW32_GetDefaultInitParams();
+    contextParams.width = 640; contextParams.height = 480;
+    contextParams.doHeadless = true;
+    bench_contexts contexts = {0};
+    for (uint i = 0; i < BENCH_MAX_THREADS; ++i) {
+        contexts.contexts[i] = EW32_contextCreate("EasyWIN32 benchmark context", contextParams);
+        EW32_textureSetCtx(contexts.contexts[i], benchTexture(contextParams.width, contextParams.height, 8));
+    }
+    for (uint nbThreads = 1; nbThreads <= BENCH_MAX_THREADS; nbThreads *= 2) {
+        char name[32];
+        snprintf(name, sizeof(name), "contexts_x%u", nbThreads);
+        uint64 frames = nbThreads * BENCH_FRAMES_PER_THREAD;
+        benchContextsStart(&contexts, nbThreads);
+        benchRun(name, contextParams.width, contextParams.height, 0, frames, frames * contextParams.width * contextParams.height, true, benchContexts, &contexts);
+        benchContextsStop(&contexts);
+    }
+    for (uint i = 0; i < BENCH_MAX_THREADS; ++i) EW32_contextDestroy(contexts.contexts[i]);
+
+    contextParams.width = contextParams.height = 64;
+    contextParams.doIdleWait = true;
+    ew32_context* idle = EW32_contextCreate("EasyWIN32 benchmark idle", contextParams);
+    benchRun("idle_request", contextParams.width, contextParams.height, 0, 1, 0, true, benchIdleRequest, idle);
+    EW32_contextDestroy(idle);
+
+    return benchWriteResults(outPath) ? 0 : 1;
+}
@@ -3,32 +3,45 @@
 #define WIDTH 200
 #define HEIGHT 150
 
+#include <string.h>
 #include "easyWIN32.h"
 
 static float VIEW_HEIGHT = 1.6;
 static const float FOV = PI*0.25;
 static const float NCP = 0.03;
 
-static ew32_texture texture;
+static ew32_texture texture; // Render target (8 bits indices into PALETTE, or 32 bits colors), set with "renderSetTarget"
+static ew32_texture_cache* TEXTURE_CACHE; // Wall textures, streamed with their mip levels
+
+// Lighting in the classic Doom style: the palette is a ramp of intensities and
+// COLORMAPS[l] maps every palette index to the same color lit by light level l
+#define NB_LIGHT_LEVELS 64
+#define MAX_LIGHT 2.0
+static uint32 PALETTE[EW32_PALETTE_SIZE];
+static uint8 COLORMAPS[NB_LIGHT_LEVELS][EW32_PALETTE_SIZE];
 
 uint32 toValue(float intensity) {
     uint8 color = floor(SL_clamp(intensity, 0.0, 1.0) * 255 + 0.5);
     return EW32_PACK_RGB(color, color, color);
 }
-void drawValue(uint x, uint y, float intensity) {
-    ((uint32*)texture.buffer)[x + y * WIDTH] = toValue(intensity);
+uint8 toIndex(float intensity) {
+    return floor(SL_clamp(intensity, 0.0, 1.0) * 255 + 0.5);
 }
-void clear() {
-    for (uint y = 0; y < HEIGHT; ++y) {
-        float d = y / (float)HEIGHT;
-        float bg = d > 0 ? d * 0.5 * 0.9 + 0.1 : 0.0;
-        for (uint x = 0; x < WIDTH; ++x) {
-            drawValue(x, y, bg);
-        }
+const uint8* lightColormap(float light) {
+    return COLORMAPS[(uint)floor(SL_clamp(light / MAX_LIGHT, 0.0, 1.0) * (NB_LIGHT_LEVELS - 1) + 0.5)];
+}
+void paletteInit() {
+    for (uint i = 0; i < EW32_PALETTE_SIZE; ++i) PALETTE[i] = toValue(i / 255.0);
+    for (uint l = 0; l < NB_LIGHT_LEVELS; ++l) {
+        float light = l * MAX_LIGHT / (NB_LIGHT_LEVELS - 1);
+        for (uint i = 0; i < EW32_PALETTE_SIZE; ++i) COLORMAPS[l][i] = toIndex(i / 255.0 * light);
     }
 }
-
-
+uint8* textureToIndexed(const float* tex, uint nbTexels) {
+    uint8* indexed = malloc(nbTexels);
+    for (uint i = 0; i < nbTexels; ++i) indexed[i] = toIndex(tex[i]);
+    return indexed;
+}
 
 typedef struct Material {
     uint type;
@@ -37,11 +50,20 @@ typedef struct Material {
             float color;
         };
         struct {
-            float* tex;
-            uint8 size;
+            uint texture; // Id in TEXTURE_CACHE (square, 8 bits palette indices)
         };
     };
 } material;
+#define WALL_STACK_SIZE 64 // Maximum number of walls drawn in a single column (the nearest ones)
+#define SPRITE_KEY 0 // Transparent palette index of sprite textures
+
+// Camera-facing billboard standing at "pos"
+typedef struct Sprite {
+    vec2 pos;
+    float floor, height, width;
+    uint texture; // Id in TEXTURE_CACHE (square, 8 bits palette indices, "SPRITE_KEY" is transparent)
+} sprite;
+
 typedef struct Wall {
     vec2 p1, p2;
     float floor, height;
@@ -105,69 +127,298 @@ float wallDist(vec2 org, vec2 dir, wall* w) {
 
     return sqrt(x*x + y*y);
 }
-void wallDraw(wall* w, uint x, float dist, vec2 dir, vec2 org) {
-    if (dist < NCP) return;
+// Rendering is done by kernels specialized for the pixel format of the target and the type of
+// material, so that no format or material check is left in the per-pixel loops
+#define NB_MATERIAL_TYPES 2
+
+typedef struct WallColumn {
+    uint x, ym, yM;
+    const uint8* colormap;
+    const ew32_texture* tex; // Mip level sampled by textured materials
+    const wall* w;
+    float dist, hm, hM;
+    vec2 dir, org;
+} wall_column;
+typedef void (func_WALL_COLUMN)(const wall_column* column);
+
+typedef struct SpriteColumn {
+    uint x, ym, yM;
+    const uint8* colormap;
+    const uint8* texels; // Top of the texture column
+    uint stride;
+    uint32 v, dv; // Texel row of "ym" and step per pixel (16.16 fixed point)
+} sprite_column;
+typedef void (func_SPRITE_COLUMN)(const sprite_column* column);
+
+typedef struct RenderKernels {
+    void (*clear)();
+    func_WALL_COLUMN* wallColumn[NB_MATERIAL_TYPES];
+    func_SPRITE_COLUMN* spriteColumn;
+} render_kernels;
+
+// 1D depth buffer filled by the wall pass: for each column, the walls that occlude something new, nearest first.
+// Walls stand on the floor, so everything farther than layer l is hidden from row "top" of l downwards ("top" only decreases).
+// Occluders past the last layer are ignored.
+#define DEPTH_LAYERS 8
+typedef struct ColumnDepth {
+    uint nbLayers;
+    struct { float dist; uint top; } layers[DEPTH_LAYERS];
+} column_depth;
+static column_depth* DEPTH; // One per column of the render target
+static uint DEPTH_CAPACITY;
+
+static const ew32_pixel_pipeline* RENDER_PIPELINE;
+static const render_kernels* RENDER_KERNELS;
+
+#define SHADE_INDEXED8(index) (index)
+#define SHADE_RGB32(index) PALETTE[index]
+
+#define DEFINE_RENDER_KERNELS(FORMAT, PIXEL) \
+static void clear_##FORMAT() { \
+    for (int y = 0; y < texture.height; ++y) { \
+        float d = y / (float)texture.height; \
+        float bg = d > 0 ? d * 0.5 * 0.9 + 0.1 : 0.0; \
+        RENDER_PIPELINE->fill((PIXEL*)texture.buffer + y * texture.width, texture.width, SHADE_##FORMAT(toIndex(bg))); \
+    } \
+} \
+static void wallColumnFlat_##FORMAT(const wall_column* c) { \
+    PIXEL* dst = (PIXEL*)texture.buffer + c->x + c->ym * texture.width; \
+    PIXEL color = SHADE_##FORMAT(c->colormap[toIndex(c->w->mat->color)]); \
+    for (uint i = c->ym; i < c->yM; i++, dst += texture.width) *dst = color; \
+} \
+static void wallColumnTextured_##FORMAT(const wall_column* c) { \
+    vec2 hitPos = addS2(c->org, c->dir, c->dist + NCP); \
+    float u = len2(sub2(hitPos, c->w->p1)); \
+    u = u - floor(u); \
+    float dv = floor((0.5 - c->hm) * texture.height); \
+    float dV = 1.0 / (float)(floor((0.5 + c->hM) * texture.height) - dv); \
+    \
+    PIXEL* dst = (PIXEL*)texture.buffer + c->x + c->ym * texture.width; \
+    uint size = c->tex->width; \
+    const uint8* column = c->tex->buffer + (uint)floor(u * size); \
+    for (uint i = c->ym; i < c->yM; i++, dst += texture.width) { \
+        float v = (i - dv) * dV; \
+        *dst = SHADE_##FORMAT(c->colormap[column[(uint)floor(v * size) * size]]); \
+    } \
+} \
+static void spriteColumn_##FORMAT(const sprite_column* c) { \
+    PIXEL* dst = (PIXEL*)texture.buffer + c->x + c->ym * texture.width; \
+    uint32 v = c->v; \
+    for (uint i = c->ym; i < c->yM; i++, dst += texture.width, v += c->dv) { \
+        uint8 texel = c->texels[(v >> 16) * c->stride]; \
+        if (texel != SPRITE_KEY) *dst = SHADE_##FORMAT(c->colormap[texel]); \
+    } \
+} \
+static const render_kernels RENDER_KERNELS_##FORMAT = { \
+    .clear = clear_##FORMAT, \
+    .wallColumn = { wallColumnFlat_##FORMAT, wallColumnTextured_##FORMAT }, \
+    .spriteColumn = spriteColumn_##FORMAT \
+};
+
+DEFINE_RENDER_KERNELS(INDEXED8, uint8)
+DEFINE_RENDER_KERNELS(RGB32, uint32)
+
+static const render_kernels* const RENDER_KERNELS_BY_FORMAT[EW32_FORMAT_COUNT] = {
+    [EW32_FORMAT_INDEXED8] = &RENDER_KERNELS_INDEXED8,
+    [EW32_FORMAT_RGB32] = &RENDER_KERNELS_RGB32,
+};
+
+// Set the texture to render into (8 or 32 bits) and pick the kernels for its format
+void renderSetTarget(ew32_texture target) {
+    ew32_pixel_format format = EW32_pixelFormatFromBitDepth(target.bitDepth);
+    if (format >= EW32_FORMAT_COUNT) {
+        fprintf(stderr, "[Doom] Unsupported render target bit depth '%d'!\n", target.bitDepth);
+        exit(1);
+    }
+    if ((uint)target.width > DEPTH_CAPACITY) {
+        column_depth* depth = realloc(DEPTH, sizeof(column_depth) * target.width);
+        if (!depth) {
+            fprintf(stderr, "[Doom] Failed to allocate the depth buffer!\n");
+            exit(1);
+        }
+        DEPTH = depth;
+        DEPTH_CAPACITY = target.width;
+    }
+    texture = target;
+    RENDER_PIPELINE = EW32_pixelPipelineGet(format, EW32_FILTER_NEAREST, EW32_BLEND_COPY);
+    RENDER_KERNELS = RENDER_KERNELS_BY_FORMAT[format];
+}
+
+void clear() {
+    RENDER_KERNELS->clear();
+}
+
+// Draw one column of a wall, return the first row it covers (the height of the target if none)
+uint wallDraw(wall* w, uint x, float dist, vec2 dir, vec2 org) {
+    if (dist < NCP || w->mat->type >= NB_MATERIAL_TYPES) return texture.height; // Unknown materials are not drawn
     float hM = (VIEW_HEIGHT) / dist;
     float hm = (w->height - VIEW_HEIGHT) / dist;
 
-    uint yM = SL_min(floor((0.5 + hM) * HEIGHT), HEIGHT);
-    uint ym = SL_max(floor((0.5 - hm) * HEIGHT), 0);
-    
     float fog = (1.0 - (dist - NCP) * 0.05);
     float diffuse = (fabs(dot2(dir, wallNormal(w))) * 1.2 + 0.0);
-    float light = fog * diffuse;
 
-    if (w->mat->type == 0) {
-        light *= w->mat->color;
-        for (uint i = ym; i < yM; i++) drawValue(x, i, light);
-    }
-    else if (w->mat->type == 1) {
-        vec2 hitPos = addS2(org, dir, dist + NCP);
-        // float u = length2(sub2(hitPos, w->p1)) / length2(sub2(w->p2, w->p1));
-        float u = len2(sub2(hitPos, w->p1));
-        u = u - floor(u);
-
-        float dv = floor((0.5 - hm) * HEIGHT);
-        float dV = 1.0 / (float)(floor((0.5 + hM) * HEIGHT) - dv);
-        for (uint i = ym; i < yM; i++) {
-            float v = (i - dv) * dV;
-
-            uint UV = floor(u * w->mat->size) + floor(v * w->mat->size) * w->mat->size;
-            float color = w->mat->tex[UV];
-            drawValue(x, i, color * light);
-        }
+    wall_column column = {
+        .x = x,
+        .yM = SL_min(floor((0.5 + hM) * texture.height), texture.height),
+        .ym = SL_max(floor((0.5 - hm) * texture.height), 0),
+        .colormap = lightColormap(fog * diffuse),
+        .w = w, .dist = dist, .hm = hm, .hM = hM,
+        .dir = dir, .org = org
+    };
+    if (w->mat->type == 1) { // Textured: pick the mip level closest to one texel per pixel
+        uint size, nbLevels, level = 0;
+        EW32_textureCacheInfo(TEXTURE_CACHE, w->mat->texture, &size, NULL, &nbLevels);
+        float texelsPerPixel = size / ((hm + hM) * texture.height);
+        for (; level + 1 < nbLevels && texelsPerPixel >= 2.0; ++level) texelsPerPixel *= 0.5;
+
+        column.tex = EW32_textureCacheGet(TEXTURE_CACHE, w->mat->texture, level);
+        if (!column.tex) return texture.height; // Not even the coarsest level fits in the budget
     }
+    if (column.ym >= column.yM) return texture.height;
+    RENDER_KERNELS->wallColumn[w->mat->type](&column);
+    return column.ym;
 }
 void sceneRender(wall* walls, uint nbWalls, vec2 playerPos, vec2 playerDir, float viewWidth) {
+    EW32_textureCacheBeginFrame(TEXTURE_CACHE); // Stream in the levels the last frame missed
     clear();
     vec2 orth = Vec2(-playerDir.y, playerDir.x);
     float viewShift = viewWidth / NCP;
 
-    for (uint i = 0; i < WIDTH; i++) {
-        struct { uint idx; float dist, height; } wallStack[64] = {0};
+    for (int i = 0; i < texture.width; i++) {
+        struct { uint idx; float dist, height; } wallStack[WALL_STACK_SIZE] = {0};
         uint wallStackIdx = 0;
 
-        float fact = (1.0 - 2.0 * i / (WIDTH - 1.0)) * viewShift;
+        float fact = (1.0 - 2.0 * i / (texture.width - 1.0)) * viewShift;
         vec2 renderDir = addS2(playerDir, orth, fact);
 
         for (uint j = 0; j < nbWalls; j++) {
             float dist = wallDist(playerPos, renderDir, walls + j);
             if (dist >= FLOAT_MAX) continue;
 
-            int k = ++wallStackIdx;
-            for (; k >= 0; k--) {
-                if (wallStack[k].dist > dist) break;
-                wallStack[k + 1] = wallStack[k];
+            // Keep the stack sorted from the farthest to the nearest wall
+            int k;
+            if (wallStackIdx < WALL_STACK_SIZE) {
+                for (k = wallStackIdx++ - 1; k >= 0 && wallStack[k].dist <= dist; k--) wallStack[k + 1] = wallStack[k];
+                k++;
+            }
+            else { // Column is saturated: only the nearest walls are kept, so the farthest one makes room
+                if (dist >= wallStack[0].dist) continue;
+                for (k = 0; k + 1 < WALL_STACK_SIZE && wallStack[k + 1].dist > dist; k++) wallStack[k] = wallStack[k + 1];
             }
-            if (k < 0) k = 0;
             wallStack[k].dist = dist;
             wallStack[k].height = walls[j].height;
             wallStack[k].idx = j;
         }
 
-        for (uint j = 0; j < wallStackIdx; j++) wallDraw(walls + wallStack[j].idx, i, wallStack[j].dist / sqrt(1.0 + fact*fact), norm2(renderDir), playerPos);
+        float perpendicular = 1.0 / sqrt(1.0 + fact*fact);
+        uint tops[WALL_STACK_SIZE];
+        for (uint j = 0; j < wallStackIdx; j++) tops[j] = wallDraw(walls + wallStack[j].idx, i, wallStack[j].dist * perpendicular, norm2(renderDir), playerPos);
+
+        // Keep the occlusion of this column for the sprites
+        column_depth* depth = DEPTH + i;
+        depth->nbLayers = 0;
+        uint top = texture.height;
+        for (int j = wallStackIdx - 1; j >= 0 && depth->nbLayers < DEPTH_LAYERS; j--) {
+            if (tops[j] >= top) continue; // Hidden by nearer walls
+            top = tops[j];
+            depth->layers[depth->nbLayers].dist = wallStack[j].dist * perpendicular;
+            depth->layers[depth->nbLayers].top = top;
+            depth->nbLayers++;
+        }
+    }
+
+}
+
+// First row hidden by walls for something at "dist" in a column
+static inline uint depthClip(const column_depth* depth, float dist) {
+    uint clip = texture.height;
+    for (uint l = 0; l < depth->nbLayers && depth->layers[l].dist < dist; l++) clip = depth->layers[l].top;
+    return clip;
+}
+
+typedef struct SpriteDraw {
+    float dist; // Perpendicular distance to the view
+    float x0, x1, y0, y1; // Projected rectangle (in pixels, unclipped)
+    const sprite* s;
+} sprite_draw;
+static sprite_draw* SPRITE_DRAWS; // Scratch of "spritesRender", grown to the largest sprite count
+static uint SPRITE_DRAWS_CAPACITY;
+static int spriteDrawCompare(const void* a, const void* b) {
+    float da = ((const sprite_draw*)a)->dist, db = ((const sprite_draw*)b)->dist;
+    return (da < db) - (da > db); // Farthest first
+}
+
+void spriteDraw(const sprite_draw* d) {
+    uint x0 = SL_max(ceil(d->x0 - 0.5), 0), x1 = SL_min(ceil(d->x1 - 0.5), texture.width);
+    uint y0 = SL_max(ceil(d->y0 - 0.5), 0), y1 = SL_min(ceil(d->y1 - 0.5), texture.height);
+    const ew32_texture* tex = NULL;
+    sprite_column column = { .colormap = lightColormap(1.0 - (d->dist - NCP) * 0.05) };
+
+    for (uint x = x0; x < x1; x++) {
+        column.yM = SL_min(y1, depthClip(DEPTH + x, d->dist));
+        if (y0 >= column.yM) continue; // Occluded: rejected before any texel fetch
+
+        if (!tex) { // Only resolve the texture once a column is known to be visible
+            uint size, nbLevels, level = 0;
+            EW32_textureCacheInfo(TEXTURE_CACHE, d->s->texture, &size, NULL, &nbLevels);
+            float texelsPerPixel = size / (d->y1 - d->y0);
+            for (; level + 1 < nbLevels && texelsPerPixel >= 2.0; ++level) texelsPerPixel *= 0.5;
+            if (!(tex = EW32_textureCacheGet(TEXTURE_CACHE, d->s->texture, level))) return;
+
+            column.stride = tex->width;
+            column.dv = (uint32)(tex->height / (d->y1 - d->y0) * 65536.0);
+            column.v = (uint32)((y0 + 0.5 - d->y0) / (d->y1 - d->y0) * tex->height * 65536.0);
+        }
+        column.x = x;
+        column.ym = y0;
+        column.texels = tex->buffer + SL_min((uint)((x + 0.5 - d->x0) / (d->x1 - d->x0) * tex->width), tex->width - 1);
+        RENDER_KERNELS->spriteColumn(&column);
+    }
+}
+// Draw sprites over the scene rendered by "sceneRender" with the same view, clipped by its depth buffer
+void spritesRender(const sprite* sprites, uint nbSprites, vec2 playerPos, vec2 playerDir, float viewWidth) {
+    if (nbSprites > SPRITE_DRAWS_CAPACITY) {
+        sprite_draw* grown = realloc(SPRITE_DRAWS, sizeof(sprite_draw) * nbSprites);
+        if (!grown) {
+            fprintf(stderr, "[Doom] Failed to allocate %u sprite draws!\n", nbSprites);
+            return;
+        }
+        SPRITE_DRAWS = grown;
+        SPRITE_DRAWS_CAPACITY = nbSprites;
+    }
+    sprite_draw* draws = SPRITE_DRAWS;
+
+    vec2 orth = Vec2(-playerDir.y, playerDir.x);
+    float columnsPerUnit = (texture.width - 1.0) * 0.5 / (viewWidth / NCP); // At a distance of 1
+    float center = (texture.width - 1.0) * 0.5;
+
+    // Project and cull
+    uint nbDraws = 0;
+    for (uint i = 0; i < nbSprites; i++) {
+        const sprite* s = sprites + i;
+        vec2 rel = sub2(s->pos, playerPos);
+        float dist = dot2(rel, playerDir);
+        if (dist < NCP) continue;
+
+        float x = center - dot2(rel, orth) / dist * columnsPerUnit, halfWidth = s->width * 0.5 / dist * columnsPerUnit;
+        float y0 = (0.5 - (s->floor + s->height - VIEW_HEIGHT) / dist) * texture.height;
+        float y1 = (0.5 + (VIEW_HEIGHT - s->floor) / dist) * texture.height;
+        if (x + halfWidth < 0 || x - halfWidth >= texture.width || y1 < 0 || y0 >= texture.height || y1 - y0 < 0.5) continue;
+
+        draws[nbDraws++] = (sprite_draw){ .dist = dist, .x0 = x - halfWidth, .x1 = x + halfWidth, .y0 = y0, .y1 = y1, .s = s };
     }
 
+    qsort(draws, nbDraws, sizeof(sprite_draw), spriteDrawCompare);
+    for (uint i = 0; i < nbDraws; i++) spriteDraw(draws + i);
+}
+
+// Free the buffers of the renderer ("renderSetTarget" must be called again before rendering)
+void renderShutdown() {
+    free(DEPTH);
+    free(SPRITE_DRAWS);
+    DEPTH = NULL;
+    SPRITE_DRAWS = NULL;
+    DEPTH_CAPACITY = SPRITE_DRAWS_CAPACITY = 0;
 }
 
 static float* TEXTURES[] = {
@@ -193,9 +444,66 @@ static float* TEXTURES[] = {
     (float[]) {
         0.0, 1.0,
         1.0, 0.0
+    },
+    (float[]) { // Sprite (0.0 is transparent)
+        0.0, 0.0, 0.6, 0.8, 0.8, 0.6, 0.0, 0.0,
+        0.0, 0.6, 1.0, 1.0, 1.0, 1.0, 0.6, 0.0,
+        0.0, 0.6, 1.0, 0.9, 0.9, 1.0, 0.6, 0.0,
+        0.0, 0.0, 0.6, 0.8, 0.8, 0.6, 0.0, 0.0,
+        0.0, 0.0, 0.0, 0.3, 0.3, 0.0, 0.0, 0.0,
+        0.0, 0.0, 0.0, 0.3, 0.3, 0.0, 0.0, 0.0,
+        0.0, 0.0, 0.0, 0.3, 0.3, 0.0, 0.0, 0.0,
+        0.0, 0.0, 0.2, 0.3, 0.3, 0.2, 0.0, 0.0,
     }
 };
 
+#define NB_TEXTURES (sizeof(TEXTURES) / sizeof(TEXTURES[0]))
+static const uint TEXTURE_SIZES[NB_TEXTURES] = { 16, 2, 8 };
+#define TEXTURE_ASSET_PATH "doom_textures.ew32t"
+#define TEXTURE_BUDGET (64 * 1024)
+
+// Bake TEXTURES (with their mip levels) into an asset file, unless it is already up to date, and stream it
+ew32_texture_cache* texturesLoad(const char* path, uint64 budget) {
+    ew32_texture indexed[NB_TEXTURES];
+    for (uint i = 0; i < NB_TEXTURES; ++i) {
+        uint size = TEXTURE_SIZES[i];
+        indexed[i] = (ew32_texture){ .width = size, .height = size, .bitDepth = 8, .buffer = textureToIndexed(TEXTURES[i], size * size) };
+    }
+    bool written = EW32_textureAssetIsCurrent(path, indexed, NB_TEXTURES, true) || EW32_textureAssetWrite(path, indexed, NB_TEXTURES, true);
+    for (uint i = 0; i < NB_TEXTURES; ++i) free(indexed[i].buffer);
+
+    return written ? EW32_textureCacheCreate(path, budget) : NULL;
+}
+
+// Simulated with fixed steps, and interpolated between the last two steps for rendering
+typedef struct Player {
+    vec2 position;
+    float angle;
+    float viewHeight, bobTime;
+} player;
+
+void playerUpdate(player* p, float dt) {
+    p->angle += (EW32_inputIsKeyDown('K') - EW32_inputIsKeyDown('M')) * 1.5 * dt;
+
+    vec2 dir = Vec2(cos(p->angle), sin(p->angle));
+    vec2 orth = Vec2(-dir.y, dir.x);
+    ivec2 move = Ivec2(EW32_inputIsKeyDown('Z') - EW32_inputIsKeyDown('S'), EW32_inputIsKeyDown('D') - EW32_inputIsKeyDown('Q'));
+    float speed = 2.5 * (1 + EW32_inputIsKeyDown(EW32_KEY_SHIFT));
+    p->position = addS2(p->position, dir, move.x * speed * dt);
+    p->position = addS2(p->position, orth, -move.y * speed * dt);
+
+    if (move.x || move.y) p->viewHeight = 1.6 + 0.1 * cos((p->bobTime += dt) * TAU * (1 + EW32_inputIsKeyDown(EW32_KEY_SHIFT)));
+}
+player playerLerp(const player* from, const player* to, float t) {
+    return (player){
+        .position = addS2(from->position, sub2(to->position, from->position), t),
+        .angle = from->angle + (to->angle - from->angle) * t,
+        .viewHeight = from->viewHeight + (to->viewHeight - from->viewHeight) * t,
+        .bobTime = to->bobTime
+    };
+}
+
+#ifndef DOOM_NO_MAIN
 int main(int argc, char** argv) {
 
     ew32_init_params params = EW32_GetDefaultInitParams();
@@ -203,17 +511,22 @@ int main(int argc, char** argv) {
     EW32_Initilize("Doom", params);
     printf("Initialized window!\n");
 
-    texture = *EW32_textureGet();
+    paletteInit();
+    EW32_textureSetPalette(PALETTE);
+    EW32_textureSet((ew32_texture){ .width = WIDTH, .height = HEIGHT, .bitDepth = 8, .buffer = malloc(WIDTH * HEIGHT) });
+    renderSetTarget(*EW32_textureGet());
+
+    TEXTURE_CACHE = texturesLoad(TEXTURE_ASSET_PATH, TEXTURE_BUDGET);
+    if (!TEXTURE_CACHE) return 1;
 
     float viewWidth = tan(FOV * 0.5) * NCP;
     
-    float angle = PI * 0.5;
-    vec2 position = vec2_zero;
+    player current = { .position = vec2_zero, .angle = PI * 0.5, .viewHeight = VIEW_HEIGHT }, previous = current;
 
     material materials[] = {
         (material){.type = 0, .color = 0.5},
         (material){.type = 0, .color = 0.5},
-        (material){.type = 1, .size = 16, .tex = TEXTURES[0]}
+        (material){.type = 1, .texture = 0}
     };
     const uint nbMaterials = sizeof(materials) / sizeof(material);
 
@@ -225,29 +538,41 @@ int main(int argc, char** argv) {
     };
     const uint nbWalls = sizeof(walls) / sizeof(wall);
 
-    double lastTime = 0.0;
+    sprite sprites[] = {
+        (sprite){.pos = Vec2(-3, 3), .floor = 0.0, .height = 1.5, .width = 1.0, .texture = 2},
+        (sprite){.pos = Vec2(2, 3), .floor = 0.0, .height = 1.5, .width = 1.0, .texture = 2},
+        (sprite){.pos = Vec2(0, 8), .floor = 0.0, .height = 1.5, .width = 1.0, .texture = 2},
+        (sprite){.pos = Vec2(-8, -11), .floor = 0.0, .height = 1.5, .width = 1.0, .texture = 2}
+    };
+    const uint nbSprites = sizeof(sprites) / sizeof(sprite);
+
     while (!EW32_ShouldClose()) {
         EW32_StartFrame();
         if (EW32_inputIsKeyDown(EW32_KEY_ESCAPE)) EW32_SetShouldClose(true);
 
-        double dt = EW32_timeDelta();
-
         // PLAYER MOVEMENT
-        angle += (EW32_inputIsKeyDown('K') - EW32_inputIsKeyDown('M')) * 1.5 * dt;
-
-        vec2 dir = Vec2(cos(angle), sin(angle));
-        vec2 orth = Vec2(-dir.y, dir.x);
-        ivec2 move = Ivec2(EW32_inputIsKeyDown('Z') - EW32_inputIsKeyDown('S'), EW32_inputIsKeyDown('D') - EW32_inputIsKeyDown('Q'));
-        position = addS2(position, dir, move.x * 2.5 * (1 + EW32_inputIsKeyDown(EW32_KEY_SHIFT)) * dt);
-        position = addS2(position, orth, -move.y * 2.5 * (1 + EW32_inputIsKeyDown(EW32_KEY_SHIFT)) * dt);
-        
-        if (move.x || move.y) VIEW_HEIGHT = 1.6 + 0.1 * cos((lastTime += dt) * TAU * (1 + EW32_inputIsKeyDown(EW32_KEY_SHIFT)));
+        while (EW32_timeTick()) {
+            previous = current;
+            playerUpdate(&current, EW32_timeTickDelta());
+        }
 
         // SCENE RENDERING
-        sceneRender(walls, nbWalls, position, dir, viewWidth);
+        player view = playerLerp(&previous, &current, EW32_timeAlpha());
+        VIEW_HEIGHT = view.viewHeight;
+        vec2 dir = Vec2(cos(view.angle), sin(view.angle));
+        sceneRender(walls, nbWalls, view.position, dir, viewWidth);
+        spritesRender(sprites, nbSprites, view.position, dir, viewWidth);
 
         EW32_EndFrame();
     }
 
+    ew32_texture_cache_stats stats = EW32_textureCacheGetStats(TEXTURE_CACHE);
+    printf("Texture cache: %llu hits, %llu misses, %llu loads, %llu evictions, %llu / %llu bytes resident\n",
+        (unsigned long long)stats.hits, (unsigned long long)stats.misses, (unsigned long long)stats.loads, (unsigned long long)stats.evictions,
+        (unsigned long long)stats.residentBytes, (unsigned long long)stats.budgetBytes);
+    EW32_textureCacheDestroy(TEXTURE_CACHE);
+    renderShutdown();
+
     return 0;
-}
\ No newline at end of file
+}
+#endif // DOOM_NO_MAIN
@@ -1,49 +1,87 @@
-#include "easyWIN32.h"
+#include <stdlib.h>
+#include <string.h>
 #include <sys/time.h>
+#include <math.h>
+
+#ifdef _WIN32
+#   include <windows.h>
+#   include <windowsx.h>
+#   include <wingdi.h>
+#else
+#   include <time.h>
+#   include <errno.h>
+#   include <pthread.h>
+// Without Win32 the library runs headless: frames are rendered into the backbuffer but never presented.
+// Keys are still indexed by their Win32 virtual key codes.
+#   define VK_LBUTTON   0x01
+#   define VK_RBUTTON   0x02
+#   define VK_MBUTTON   0x04
+#   define VK_XBUTTON1  0x05
+#   define VK_XBUTTON2  0x06
+#   define VK_BACK      0x08
+#   define VK_TAB       0x09
+#   define VK_SHIFT     0x10
+#   define VK_CONTROL   0x11
+#   define VK_ESCAPE    0x1B
+#   define VK_ACCEPT    0x1E
+#   define VK_SPACE     0x20
+#   define VK_LEFT      0x25
+#   define VK_UP        0x26
+#   define VK_RIGHT     0x27
+#   define VK_DOWN      0x28
+#   define VK_LSHIFT    0xA0
+#   define VK_RSHIFT    0xA1
+#   define VK_LCONTROL  0xA2
+#   define VK_RCONTROL  0xA3
+#endif
 
-#include <windows.h>
-#include <windowsx.h>
-#include <wingdi.h>
+#include "easyWIN32.h"
 
-#define INPUT_NB_KEYS_KEYBOARD 256 // Really 254, and even lower still if we exclude mouse, reserved and other languages
-#define INPUT_NB_KEYS_MOUSE EW32_KEY_MOUSE_X2 // Left, Middle, Right, X1 and X2
+#define INPUT_NB_KEYS_KEYBOARD EW32_INPUT_NB_KEYS // Really 254, and even lower still if we exclude mouse, reserved and other languages
 typedef struct EasyWIN32_Input {
 
-    ew32_input_state states[INPUT_NB_KEYS_KEYBOARD];
-    bool shouldUpdateKeyboard;
+    // Live state, updated by window messages
+    ew32_key_set down;
+    ew32_key_set wentDown, wentUp, repeat, doubleClick; // Events accumulated since the start of the frame
     char text[1024]; // Text input resulting from WM_CHAR calls
     uint textLength;
-
-    bool shouldUpdateMouse;
     int mouseX, mouseY, scroll;
 
+    ew32_input_snapshot frame; // State of the current frame
+
 } ew32_input;
 
-static int EW32KeyToWin32(ew32_key key) {
-    if (('0' <= key && key <= '9') || ('A' <= key && key <= 'Z') || key <= 6) return key;
-    
-    switch (key) {
-        case EW32_KEY_SPACE:        return VK_SPACE;
-        case EW32_KEY_TAB:          return VK_TAB;
-        case EW32_KEY_ENTER:        return VK_ACCEPT;
-        case EW32_KEY_BACK:         return VK_BACK;
-        case EW32_KEY_ARROW_DOWN:   return VK_DOWN;
-        case EW32_KEY_ARROW_UP:     return VK_UP;
-        case EW32_KEY_ARROW_LEFT:   return VK_LEFT;
-        case EW32_KEY_ARROW_RIGHT:  return VK_RIGHT;
-        case EW32_KEY_SHIFT:        return VK_SHIFT;
-        case EW32_KEY_SHIFT_L:      return VK_LSHIFT;
-        case EW32_KEY_SHIFT_R:      return VK_RSHIFT;
-        case EW32_KEY_CTRL:         return VK_CONTROL;
-        case EW32_KEY_CTRL_L:       return VK_LCONTROL;
-        case EW32_KEY_CTRL_R:       return VK_RCONTROL;
-        case EW32_KEY_ESCAPE:       return VK_ESCAPE;
-    
-        default: fprintf(stderr, "[EasyWIN32] Key '%d' not assigned!\n", key); return 0;
-    }
-}
+#define KEY_ID(key) [key] = key
+// Win32 virtual key code of every ew32_key (0 if not assigned)
+static const uint8 EW32_KEY_TO_WIN32[EW32_KEY_COUNT] = {
+    KEY_ID(EW32_KEY_MOUSE_LEFT), KEY_ID(EW32_KEY_MOUSE_RIGHT), KEY_ID(EW32_KEY_MOUSE_MIDDLE), KEY_ID(EW32_KEY_MOUSE_X1), KEY_ID(EW32_KEY_MOUSE_X2),
+
+    KEY_ID('0'), KEY_ID('1'), KEY_ID('2'), KEY_ID('3'), KEY_ID('4'), KEY_ID('5'), KEY_ID('6'), KEY_ID('7'), KEY_ID('8'), KEY_ID('9'),
+
+    KEY_ID('A'), KEY_ID('B'), KEY_ID('C'), KEY_ID('D'), KEY_ID('E'), KEY_ID('F'), KEY_ID('G'), KEY_ID('H'), KEY_ID('I'),
+    KEY_ID('J'), KEY_ID('K'), KEY_ID('L'), KEY_ID('M'), KEY_ID('N'), KEY_ID('O'), KEY_ID('P'), KEY_ID('Q'), KEY_ID('R'),
+    KEY_ID('S'), KEY_ID('T'), KEY_ID('U'), KEY_ID('V'), KEY_ID('W'), KEY_ID('X'), KEY_ID('Y'), KEY_ID('Z'),
+
+    [EW32_KEY_SPACE]        = VK_SPACE,
+    [EW32_KEY_TAB]          = VK_TAB,
+    [EW32_KEY_ENTER]        = VK_ACCEPT,
+    [EW32_KEY_BACK]         = VK_BACK,
+    [EW32_KEY_ARROW_DOWN]   = VK_DOWN,
+    [EW32_KEY_ARROW_UP]     = VK_UP,
+    [EW32_KEY_ARROW_LEFT]   = VK_LEFT,
+    [EW32_KEY_ARROW_RIGHT]  = VK_RIGHT,
+    [EW32_KEY_SHIFT]        = VK_SHIFT,
+    [EW32_KEY_SHIFT_L]      = VK_LSHIFT,
+    [EW32_KEY_SHIFT_R]      = VK_RSHIFT,
+    [EW32_KEY_CTRL]         = VK_CONTROL,
+    [EW32_KEY_CTRL_L]       = VK_LCONTROL,
+    [EW32_KEY_CTRL_R]       = VK_RCONTROL,
+    [EW32_KEY_ESCAPE]       = VK_ESCAPE,
+};
+#undef KEY_ID
 
 #define NB_SMOOTH_DT 128
+#define DEFAULT_MAX_TICKS_PER_FRAME 8 // Also used when "maxTicksPerFrame" is 0, which would drop all the time
 typedef struct EasyWIN32_Time {
     double dt;
     double smoothDt;
@@ -54,16 +92,32 @@ typedef struct EasyWIN32_Time {
     double lastDts[NB_SMOOTH_DT];
     uint lastDtIndex;
     double appStartDate;
+
+    // Fixed-step scheduler
+    double tickDt; // 0 when disabled
+    uint maxTicksPerFrame;
+    double accumulator; // Time not simulated yet
+    uint pendingTicks; // Steps left to run this frame
+    uint64 tickCount;
+    double droppedTime; // Time skipped to avoid catching up forever
 } ew32_time;
 
 typedef struct RenderBuffer {
     ew32_texture texture;
+    uint32 palette[EW32_PALETTE_SIZE]; // Used to expand 8 bits textures
+    uint32* expanded; // 32 bits copy of an 8 bits texture, filled at present time
+    const ew32_pixel_pipeline* pipeline; // Kernels for the texture's format, NULL if it has none
+#ifdef _WIN32
     BITMAPINFO header;
+#endif
 } render_buffer;
 
-static struct MainWIN32 {
+struct EasyWIN32_Context {
     const char* name;
-    HWND window;
+#ifdef _WIN32
+    HWND window; // NULL when headless
+#endif
+    bool headless;
     int currentWidth, currentHeight;
 
     func_WM_PAINT_CALLBACK* wmPaintCallback;
@@ -74,62 +128,185 @@ static struct MainWIN32 {
     bool shouldClose;
     bool alwaysRedrawframe;
     bool bilinearInterpolation;
-} MAIN_W32;
 
-bool EW32_ShouldClose() {
-    return MAIN_W32.shouldClose;
+    // Idle mode
+    bool idleWait;
+    double idleMaxWait; // In seconds, no limit if <= 0
+    uint64 redrawDeadline; // "EW32_profileNow" time of the next timed redraw, 0 if none
+    bool inputEvent; // An input event arrived since the start of the last frame
+    bool needsRedraw; // Wether the current frame will be presented
+#ifdef _WIN32
+    HANDLE wakeEvent; // Auto-reset, signaled by "EW32_RequestRedraw"
+#else
+    pthread_mutex_t wakeLock;
+    pthread_cond_t wakeCondition;
+    bool wakeRequested;
+#endif
+};
+
+static ew32_context* DEFAULT_CONTEXT = NULL; // Used by the functions without a context parameter
+
+static void easyWIN32_SelectPipeline(ew32_context* ctx) {
+    ew32_filter filter = ctx->bilinearInterpolation ? EW32_FILTER_BILINEAR : EW32_FILTER_NEAREST;
+    ctx->backbuffer.pipeline = EW32_pixelPipelineGet(EW32_pixelFormatFromBitDepth(ctx->backbuffer.texture.bitDepth), filter, EW32_BLEND_COPY);
+}
+
+bool EW32_ShouldCloseCtx(ew32_context* ctx) {
+    return ctx->shouldClose;
+}
+void EW32_SetShouldCloseCtx(ew32_context* ctx, bool value) {
+    ctx->shouldClose = value;
+}
+
+ew32_texture* EW32_textureGetCtx(ew32_context* ctx) {
+    return &ctx->backbuffer.texture;
 }
-void EW32_SetShouldClose(bool value) {
-    MAIN_W32.shouldClose = value;
+void EW32_textureSetCtx(ew32_context* ctx, ew32_texture texture) {
+    free(ctx->backbuffer.texture.buffer);
+    free(ctx->backbuffer.expanded);
+    ctx->backbuffer.texture = texture;
+    ctx->backbuffer.expanded = texture.bitDepth == 8 ? malloc(sizeof(uint32) * texture.width * texture.height) : NULL;
+    easyWIN32_SelectPipeline(ctx);
+#ifdef _WIN32
+    ctx->backbuffer.header.bmiHeader.biBitCount = texture.bitDepth == 8 ? 32 : texture.bitDepth; // 8 bits textures are presented expanded
+    ctx->backbuffer.header.bmiHeader.biHeight = -texture.height;
+    ctx->backbuffer.header.bmiHeader.biWidth = texture.width;
+#endif
 }
 
-ew32_texture* EW32_textureGet() {
-    return &MAIN_W32.backbuffer.texture;
+void EW32_textureSetPaletteCtx(ew32_context* ctx, const uint32* palette) {
+    memcpy(ctx->backbuffer.palette, palette, sizeof(ctx->backbuffer.palette));
 }
-void EW32_textureSet(ew32_texture texture) {
-    free(MAIN_W32.backbuffer.texture.buffer);
-    MAIN_W32.backbuffer.texture = texture;
-    MAIN_W32.backbuffer.header.bmiHeader.biBitCount = texture.bitDepth;
-    MAIN_W32.backbuffer.header.bmiHeader.biHeight = -texture.height;
-    MAIN_W32.backbuffer.header.bmiHeader.biWidth = texture.width;
+
+// Get the pixels to present, expanding 8 bits textures through the palette
+static void* easyWIN32_ResolveBackbuffer(ew32_context* ctx) {
+    render_buffer* backbuffer = &ctx->backbuffer;
+    if (!backbuffer->pipeline || !backbuffer->pipeline->expand) return backbuffer->texture.buffer;
+
+    EW32_PROFILE_BEGIN("EW32_ExpandIndexed");
+    backbuffer->pipeline->expand(backbuffer->expanded, backbuffer->texture.buffer, backbuffer->texture.width * backbuffer->texture.height, backbuffer->palette);
+    EW32_PROFILE_END();
+    return backbuffer->expanded;
 }
 
-void EW32_windowGetSize(uint* x, uint* y) {
-    *x = MAIN_W32.currentWidth;
-    *y = MAIN_W32.currentHeight;
+void EW32_windowGetSizeCtx(ew32_context* ctx, uint* x, uint* y) {
+    *x = ctx->currentWidth;
+    *y = ctx->currentHeight;
 }
 
 
 
-double EW32_timeDelta() { return MAIN_W32.time.dt; }
-double EW32_timeSmoothDelta() { return MAIN_W32.time.smoothDt; }
-double EW32_timeAtFrameStart() { return MAIN_W32.time.timeAtFrameStart; }
-uint64 EW32_timeFrameCount() { return MAIN_W32.time.frameCount; }
+double EW32_timeDeltaCtx(ew32_context* ctx) { return ctx->time.dt; }
+double EW32_timeSmoothDeltaCtx(ew32_context* ctx) { return ctx->time.smoothDt; }
+double EW32_timeAtFrameStartCtx(ew32_context* ctx) { return ctx->time.timeAtFrameStart; }
+uint64 EW32_timeFrameCountCtx(ew32_context* ctx) { return ctx->time.frameCount; }
+
+// Schedule the fixed steps of the next frame from the time the last one took
+static void easyWIN32_UpdateFixedStep(ew32_time* time) {
+    if (time->tickDt <= 0.0) return;
+
+    time->accumulator += time->dt;
+    double due = floor(time->accumulator / time->tickDt);
+    if (due > time->maxTicksPerFrame) { // Too far behind (hitch, breakpoint, idle wait...): drop the excess instead of spiraling
+        time->droppedTime += (due - time->maxTicksPerFrame) * time->tickDt;
+        time->accumulator -= (due - time->maxTicksPerFrame) * time->tickDt;
+        due = time->maxTicksPerFrame;
+    }
+    time->pendingTicks = (uint)due;
+}
+
+bool EW32_timeTickCtx(ew32_context* ctx) {
+    ew32_time* time = &ctx->time;
+    if (!time->pendingTicks) return false;
+    time->pendingTicks--;
+    time->accumulator -= time->tickDt;
+    time->tickCount++;
+    return true;
+}
+double EW32_timeTickDeltaCtx(ew32_context* ctx) { return ctx->time.tickDt; }
+uint64 EW32_timeTickCountCtx(ew32_context* ctx) { return ctx->time.tickCount; }
+double EW32_timeAlphaCtx(ew32_context* ctx) {
+    ew32_time* time = &ctx->time;
+    if (time->tickDt <= 0.0) return 1.0;
+    double alpha = (time->accumulator - time->pendingTicks * time->tickDt) / time->tickDt; // As it will be once every step ran
+    return alpha < 0.0 ? 0.0 : alpha > 1.0 ? 1.0 : alpha;
+}
+double EW32_timeDroppedCtx(ew32_context* ctx) { return ctx->time.droppedTime; }
+
+// Compute the state of the new frame from the live state.
+// Edges come from the events themselves (a key can go up and down several times in a frame), so the sets are copied as is.
+static void easyWIN32_UpdateInputState(ew32_context* ctx) {
+    ew32_input* input = &ctx->input;
+    ew32_input_snapshot* frame = &input->frame;
+
+    frame->down = input->down;
+    frame->pressed = input->wentDown;
+    frame->released = input->wentUp;
+    frame->doubleClick = input->doubleClick;
+    for (uint i = 0; i < EW32_KEY_SET_WORDS; ++i) frame->repeat.bits[i] = input->repeat.bits[i] & input->down.bits[i];
+    frame->mouseX = input->mouseX;
+    frame->mouseY = input->mouseY;
+    frame->scroll = input->scroll;
+
+    input->wentDown = input->wentUp = input->repeat = input->doubleClick = (ew32_key_set){0};
+    input->scroll = 0;
+    input->textLength = 0;
+}
+
+// Apply a key event to the live input state (key is a Win32 virtual key code)
+static void easyWIN32_SetKeyState(ew32_context* ctx, uint key, bool down, bool repeat, bool doubleClick) {
+    ew32_input* input = &ctx->input;
+    uint word = key >> 6;
+    uint64 bit = 1ull << (key & 63);
 
-static void easyWIN32_InitializeInput() {
-    for (uint i = 0; i < INPUT_NB_KEYS_KEYBOARD; ++i) MAIN_W32.input.states[i] = EW32_INPUT_UP;
-    MAIN_W32.input.textLength = 0;
-    MAIN_W32.input.scroll = 0;
+    if (down) {
+        input->wentDown.bits[word] |= bit & ~input->down.bits[word]; // Repeated key downs are not presses
+        input->down.bits[word] |= bit;
+    }
+    else {
+        input->wentUp.bits[word] |= bit & input->down.bits[word];
+        input->down.bits[word] &= ~bit;
+    }
+    if (repeat) input->repeat.bits[word] |= bit;
+    if (doubleClick) input->doubleClick.bits[word] |= bit;
+    ctx->inputEvent = true;
 }
-static void easyWIN32_UpdateInputState() {
-    if (MAIN_W32.input.shouldUpdateKeyboard) for (uint i = 0; i < INPUT_NB_KEYS_KEYBOARD; ++i) MAIN_W32.input.states[i] &= (EW32_INPUT_DOWN | EW32_INPUT_UP); // Get rid of Pressed and Released states
-    if (MAIN_W32.input.shouldUpdateMouse) for (uint i = 0; i < INPUT_NB_KEYS_MOUSE; ++i) MAIN_W32.input.states[i] &= (EW32_INPUT_DOWN | EW32_INPUT_UP);
-    MAIN_W32.input.scroll = 0;
-    MAIN_W32.input.textLength = 0;
+
+// Key indices are looked up directly in the key sets
+_Static_assert((1u << (8 * sizeof(EW32_KEY_TO_WIN32[0]))) <= EW32_INPUT_NB_KEYS, "Win32 key indices must fit in a key set");
+
+int EW32_inputKeyIndex(ew32_key key) {
+    return (uint)key < sizeof(EW32_KEY_TO_WIN32) ? EW32_KEY_TO_WIN32[key] : 0;
 }
+ew32_input_state EW32_inputGetKeyStateCtx(ew32_context* ctx, ew32_key key) {
+    int index = EW32_inputKeyIndex(key);
+    if (!index) return 0;
 
-ew32_input_state EW32_inputGetKeyState(ew32_key key) {
-    int w32Key = EW32KeyToWin32(key);
-    if (!w32Key) return 0;
+    return EW32_snapshotGetKeyState(&ctx->input.frame, index);
+}
+ew32_input_snapshot EW32_inputGetSnapshotCtx(ew32_context* ctx) {
+    return ctx->input.frame;
+}
+void EW32_inputSimulateKeyCtx(ew32_context* ctx, ew32_key key, bool down) {
+    int index = EW32_inputKeyIndex(key);
+    if (!index) return;
 
-    return MAIN_W32.input.states[w32Key];
+    bool repeat = down && EW32_keySetHas(&ctx->input.down, index);
+    easyWIN32_SetKeyState(ctx, index, down, repeat, false); // The pending input skips the next idle wait
 }
 
+#ifdef _WIN32
+
 
 
 // Callback for dealing with incomming Windows messages
 LRESULT CALLBACK easyWIN32_WindowProc(HWND window, UINT msg, WPARAM wParam, LPARAM lParam) {
     LRESULT ret = 0;
+
+    // The context is attached to its window on creation
+    if (msg == WM_NCCREATE) SetWindowLongPtr(window, GWLP_USERDATA, (LONG_PTR)((CREATESTRUCT*)lParam)->lpCreateParams);
+    ew32_context* ctx = (ew32_context*)GetWindowLongPtr(window, GWLP_USERDATA);
+    if (!ctx) return DefWindowProc(window, msg, wParam, lParam);
     
     ///// INPUT
     ew32_input_state state = EW32_INPUT_UP;
@@ -138,16 +315,18 @@ LRESULT CALLBACK easyWIN32_WindowProc(HWND window, UINT msg, WPARAM wParam, LPAR
 
     switch (msg) {
         case WM_SIZE: { // Window resize
-            MAIN_W32.currentWidth = LOWORD(lParam);
-            MAIN_W32.currentHeight = HIWORD(lParam);
+            ctx->currentWidth = LOWORD(lParam);
+            ctx->currentHeight = HIWORD(lParam);
+            ctx->inputEvent = true;
         } break;
 
         case WM_DESTROY: { // Window getting destroyed
-            PostQuitMessage(0);
+            ctx->window = NULL;
+            ctx->shouldClose = true;
         } break;
 
         case WM_CLOSE: { // [X] top-right button or ALT-F4
-            PostQuitMessage(0);
+            ctx->shouldClose = true;
         } break;
 
         case WM_ACTIVATE: { // Wether the ACTIVATED state has changed (aka. the focus has been shifted to / away from this window)
@@ -156,35 +335,40 @@ LRESULT CALLBACK easyWIN32_WindowProc(HWND window, UINT msg, WPARAM wParam, LPAR
         } break;
 
         case WM_PAINT: { // When trying to refresh the window buffer
+            EW32_PROFILE_BEGIN("EW32_Blit");
             PAINTSTRUCT paint;
             HDC deviceContext = BeginPaint(window, &paint);
-            SetStretchBltMode(deviceContext, MAIN_W32.bilinearInterpolation ? STRETCH_HALFTONE : STRETCH_DELETESCANS);
+            SetStretchBltMode(deviceContext, ctx->bilinearInterpolation ? STRETCH_HALFTONE : STRETCH_DELETESCANS);
             
-            if (MAIN_W32.wmPaintCallback) MAIN_W32.wmPaintCallback(&paint, deviceContext);
+            if (ctx->wmPaintCallback) ctx->wmPaintCallback(&paint, deviceContext);
+            void* pixels = easyWIN32_ResolveBackbuffer(ctx);
 
             StretchDIBits(deviceContext,
                 paint.rcPaint.left, paint.rcPaint.top,                                              // Destination pos
                 paint.rcPaint.right - paint.rcPaint.left, paint.rcPaint.bottom - paint.rcPaint.top, // Destination size
                 
                 0, 0,                                                                               // Source pos
-                MAIN_W32.backbuffer.texture.width, MAIN_W32.backbuffer.texture.height,              // Source size
+                ctx->backbuffer.texture.width, ctx->backbuffer.texture.height,                      // Source size
 
-                MAIN_W32.backbuffer.texture.buffer,                                                 // Source data
-                (void*)&MAIN_W32.backbuffer.header,                                                 // Source bitmap header
+                pixels,                                                                             // Source data
+                (void*)&ctx->backbuffer.header,                                                     // Source bitmap header
                 DIB_RGB_COLORS,                                                                     // Color mode (indexed or raw RGB)
                 SRCCOPY                                                                             // Data copy mode
             );
             EndPaint(window, &paint);
+            EW32_PROFILE_END();
         } break;
 
         case WM_NCMOUSEMOVE: // To access the top bar
         case WM_MOUSEMOVE: {
-            MAIN_W32.input.mouseX = GET_X_LPARAM(lParam);
-            MAIN_W32.input.mouseY = GET_Y_LPARAM(lParam);
+            ctx->input.mouseX = GET_X_LPARAM(lParam);
+            ctx->input.mouseY = GET_Y_LPARAM(lParam);
+            ctx->inputEvent = true;
         } break;
 
         case WM_MOUSEWHEEL: {
-            MAIN_W32.input.scroll += GET_WHEEL_DELTA_WPARAM(wParam);
+            ctx->input.scroll += GET_WHEEL_DELTA_WPARAM(wParam);
+            ctx->inputEvent = true;
         } break;
 
         case WM_LBUTTONDBLCLK: doubleClick = true;
@@ -208,33 +392,14 @@ LRESULT CALLBACK easyWIN32_WindowProc(HWND window, UINT msg, WPARAM wParam, LPAR
             goto HANDLE_MOUSE;
 
         HANDLE_MOUSE: {
-            if (MAIN_W32.input.states[mouseButton] & EW32_INPUT_DOWN && state == EW32_INPUT_UP) {
-                MAIN_W32.input.states[mouseButton] = EW32_INPUT_RELEASED;
-                MAIN_W32.input.shouldUpdateMouse = true;
-            }
-            else if (MAIN_W32.input.states[mouseButton] & EW32_INPUT_UP && state == EW32_INPUT_DOWN) {
-                MAIN_W32.input.states[mouseButton] = EW32_INPUT_PRESSED;
-                MAIN_W32.input.shouldUpdateMouse = true;
-            }
-            else MAIN_W32.input.states[mouseButton] = state;
-            if (doubleClick) MAIN_W32.input.states[mouseButton] |= EW32_INPUT_DOUBLE_CLICK;
+            easyWIN32_SetKeyState(ctx, mouseButton, state == EW32_INPUT_DOWN, false, doubleClick);
         } break;
 
         case WM_KEYDOWN: state = EW32_INPUT_DOWN;
         case WM_KEYUP: {
-            uint key = LOWORD(wParam);
+            uint key = LOWORD(wParam) & (INPUT_NB_KEYS_KEYBOARD - 1);
             bool repeat = state == EW32_INPUT_DOWN && (HIWORD(lParam) & KF_REPEAT) == KF_REPEAT;
-
-            if (MAIN_W32.input.states[key] & EW32_INPUT_DOWN && state == EW32_INPUT_UP) {
-                MAIN_W32.input.states[key] = EW32_INPUT_RELEASED;
-                MAIN_W32.input.shouldUpdateKeyboard = true;
-            }
-            else if (MAIN_W32.input.states[key] & EW32_INPUT_UP && state == EW32_INPUT_DOWN) {
-                MAIN_W32.input.states[key] = EW32_INPUT_PRESSED;
-                MAIN_W32.input.shouldUpdateKeyboard = true;
-            }
-            else MAIN_W32.input.states[key] = state;
-            if (repeat) MAIN_W32.input.states[key] |= EW32_INPUT_REPEAT;
+            easyWIN32_SetKeyState(ctx, key, state == EW32_INPUT_DOWN, repeat, false);
         } break;
 
         case WM_CHAR: // For UTF-8 or UTF-16
@@ -243,11 +408,11 @@ LRESULT CALLBACK easyWIN32_WindowProc(HWND window, UINT msg, WPARAM wParam, LPAR
         {
             uint16 character = LOWORD(wParam);
             if (((character >> 8) & 0b11000000) == 0b10000000) {
-                MAIN_W32.input.text[MAIN_W32.input.textLength++] = (uint8)(wParam >> 8);
-                MAIN_W32.input.text[MAIN_W32.input.textLength++] = (uint8)wParam;
+                ctx->input.text[ctx->input.textLength++] = (uint8)(wParam >> 8);
+                ctx->input.text[ctx->input.textLength++] = (uint8)wParam;
             }
-            else MAIN_W32.input.text[MAIN_W32.input.textLength++] = (uint8)wParam;
-            
+            else ctx->input.text[ctx->input.textLength++] = (uint8)wParam;
+            ctx->inputEvent = true;
         } break;
 
         default: {
@@ -258,6 +423,8 @@ LRESULT CALLBACK easyWIN32_WindowProc(HWND window, UINT msg, WPARAM wParam, LPAR
     return ret;
 }
 
+#endif
+
 /*
 int CALLBACK WinMain(HINSTANCE instance, HINSTANCE prevInstance, LPSTR commandLine, int showCode) {
     
@@ -265,7 +432,6 @@ int CALLBACK WinMain(HINSTANCE instance, HINSTANCE prevInstance, LPSTR commandLi
         .name = "EasyWIN32",
         .currentWidth = EW32_BASE_WIDTH,
         .currentHeight = EW32_BASE_HEIGHT,
-        .input = {0},
         .backbuffer = {
             .texture = {
                 .bitDepth = 32,
@@ -333,15 +499,60 @@ ew32_init_params EW32_GetDefaultInitParams() {
         .doDoubleClick = true,
         .doAlwaysRedrawFrame = true,
         .doBilinearInterpolation = true,
+        .doHeadless = false,
+        .doIdleWait = false,
+        .idleMaxWait = 1.0,
+        .tickRate = 60.0,
+        .maxTicksPerFrame = DEFAULT_MAX_TICKS_PER_FRAME,
         .wmPaintCallback = NULL
     };
 }
-void EW32_Initilize(char* windowName, ew32_init_params params) {
-    MAIN_W32 = (struct MainWIN32) {
+#ifdef _WIN32
+static bool easyWIN32_CreateWindow(ew32_context* ctx, ew32_init_params params) {
+    WNDCLASS windowClass = {
+        .style = CS_OWNDC | CS_HREDRAW | CS_VREDRAW, // Has own DC, redraws when changing horizontal / vertical size
+        .lpfnWndProc = easyWIN32_WindowProc,
+        .hInstance = NULL,
+        .lpszClassName = ctx->name
+    };
+    if (params.doDoubleClick) windowClass.style |= CS_DBLCLKS;
+
+    RegisterClass(&windowClass); // Fails harmlessly if a context already registered this name
+
+    ctx->window = CreateWindowEx(
+        0,                              // Optional window styles.
+        ctx->name,                      // Window class
+        EW32_BASE_NAME,                 // Window text
+        WS_OVERLAPPEDWINDOW,            // Window style
+        CW_USEDEFAULT, CW_USEDEFAULT, CW_USEDEFAULT, CW_USEDEFAULT, // Size and position
+        NULL,                           // Parent window    
+        NULL,                           // Menu
+        NULL,                           // Instance handle (NULL == current)
+        ctx                             // Additional application data (retrieved in WM_NCCREATE)
+    );
+    if (!ctx->window) {
+        fprintf(stderr, "[EasyWIN32] Failed to create window!\n");
+        return false;
+    }
+    ShowWindow(ctx->window, SW_SHOWDEFAULT);
+    return true;
+}
+#endif
+
+ew32_context* EW32_contextCreate(const char* windowName, ew32_init_params params) {
+#ifndef _WIN32
+    params.doHeadless = true; // No window without Win32
+#endif
+    ew32_context* ctx = malloc(sizeof(ew32_context));
+    if (!ctx) {
+        fprintf(stderr, "[EasyWIN32] Failed to allocate context!\n");
+        return NULL;
+    }
+    *ctx = (ew32_context) {
         .name = windowName,
+        .headless = params.doHeadless,
         .currentWidth = params.width,
         .currentHeight = params.height,
-        .input = {0},
         .backbuffer = {
             .texture = {
                 .bitDepth = 32,
@@ -349,9 +560,10 @@ void EW32_Initilize(char* windowName, ew32_init_params params) {
                 .height = params.height,
                 .buffer = malloc(sizeof(uint32) * params.width * params.height),
             },
+#ifdef _WIN32
             .header = (BITMAPINFO) {
                 .bmiHeader = {
-                    .biSize = sizeof(MAIN_W32.backbuffer.header),
+                    .biSize = sizeof(ctx->backbuffer.header),
                     .biWidth = params.width,
                     .biHeight = -params.height,
                     .biPlanes = 1,
@@ -364,69 +576,227 @@ void EW32_Initilize(char* windowName, ew32_init_params params) {
                     // .biClrImportant = 0
                 }
             }
+#endif
         },
         .shouldClose = false,
         .alwaysRedrawframe = params.doAlwaysRedrawFrame,
         .bilinearInterpolation = params.doBilinearInterpolation,
-        .wmPaintCallback = params.wmPaintCallback
-    };
-
-    WNDCLASS windowClass = {
-        .style = CS_OWNDC | CS_HREDRAW | CS_VREDRAW, // Has own DC, redraws when changing horizontal / vertical size
-        .lpfnWndProc = easyWIN32_WindowProc,
-        .hInstance = NULL,
-        .lpszClassName = MAIN_W32.name
+        .wmPaintCallback = params.wmPaintCallback,
+        .time = {
+            .tickDt = params.tickRate > 0.0 ? 1.0 / params.tickRate : 0.0,
+            .maxTicksPerFrame = params.maxTicksPerFrame ? params.maxTicksPerFrame : DEFAULT_MAX_TICKS_PER_FRAME
+        },
+        .idleWait = params.doIdleWait,
+        .idleMaxWait = params.idleMaxWait,
+        .needsRedraw = true
     };
-    if (params.doDoubleClick) windowClass.style |= CS_DBLCLKS;
-
-    RegisterClass(&windowClass);
 
-    MAIN_W32.window = CreateWindowEx(
-        0,                              // Optional window styles.
-        MAIN_W32.name,                  // Window class
-        EW32_BASE_NAME,                 // Window text
-        WS_OVERLAPPEDWINDOW,            // Window style
-        CW_USEDEFAULT, CW_USEDEFAULT, CW_USEDEFAULT, CW_USEDEFAULT, // Size and position
-        NULL,                           // Parent window    
-        NULL,                           // Menu
-        NULL,                           // Instance handle (NULL == current)
-        NULL                            // Additional application data
-    );
-    if (!MAIN_W32.window) {
-        fprintf(stderr, "[EasyWIN32] Failed to create window!\n");
-        exit(0); // wParam for exiting the app before statring the message loop
+#ifdef _WIN32
+    ctx->wakeEvent = CreateEvent(NULL, FALSE, FALSE, NULL);
+    if (!ctx->wakeEvent) {
+        fprintf(stderr, "[EasyWIN32] Failed to create wake event!\n");
+        free(ctx->backbuffer.texture.buffer);
+        free(ctx);
+        return NULL;
+    }
+#else
+    pthread_condattr_t conditionAttributes;
+    pthread_condattr_init(&conditionAttributes);
+    pthread_condattr_setclock(&conditionAttributes, CLOCK_MONOTONIC); // Same clock as "EW32_profileNow"
+    pthread_cond_init(&ctx->wakeCondition, &conditionAttributes);
+    pthread_condattr_destroy(&conditionAttributes);
+    pthread_mutex_init(&ctx->wakeLock, NULL);
+#endif
+
+#ifdef _WIN32
+    if (!ctx->headless && !easyWIN32_CreateWindow(ctx, params)) {
+        CloseHandle(ctx->wakeEvent);
+        free(ctx->backbuffer.texture.buffer);
+        free(ctx);
+        return NULL;
     }
-    ShowWindow(MAIN_W32.window, SW_SHOWDEFAULT);
+#endif
+
+    for (uint i = 0; i < EW32_PALETTE_SIZE; ++i) ctx->backbuffer.palette[i] = EW32_PACK_RGB(i, i, i); // Grayscale until set
+    easyWIN32_SelectPipeline(ctx);
 
     struct timeval tv;
     gettimeofday(&tv, NULL);
-    MAIN_W32.time.appStartDate = tv.tv_sec + tv.tv_usec * 1e-6;
+    ctx->time.appStartDate = tv.tv_sec + tv.tv_usec * 1e-6;
+
+    return ctx;
+}
+void EW32_contextDestroy(ew32_context* ctx) {
+    if (!ctx) return;
+#ifdef _WIN32
+    if (ctx->window) {
+        SetWindowLongPtr(ctx->window, GWLP_USERDATA, 0);
+        DestroyWindow(ctx->window);
+    }
+    CloseHandle(ctx->wakeEvent);
+#else
+    pthread_cond_destroy(&ctx->wakeCondition);
+    pthread_mutex_destroy(&ctx->wakeLock);
+#endif
+    free(ctx->backbuffer.texture.buffer);
+    free(ctx->backbuffer.expanded);
+    if (ctx == DEFAULT_CONTEXT) DEFAULT_CONTEXT = NULL;
+    free(ctx);
+}
+ew32_context* EW32_contextGetDefault() {
+    return DEFAULT_CONTEXT;
 }
 
-void EW32_StartFrame() {
-    MSG msg = {0};
-    while (PeekMessage(&msg, 0, 0, 0, PM_REMOVE)) {
-        
-        if (msg.message == WM_QUIT) EW32_SetShouldClose(true);
+///// IDLE MODE
+
+#define IDLE_WAIT_FOREVER ((uint64)-1)
+
+// Block until "EW32_RequestRedraw" is called or the timeout (in ns) runs out, window messages also end the wait.
+// Return wether a redraw was requested (a timeout of 0 only polls for a request).
+static bool easyWIN32_WaitForWake(ew32_context* ctx, uint64 timeout) {
+#ifdef _WIN32
+    uint64 rounded = timeout == IDLE_WAIT_FOREVER ? INFINITE : (timeout + 999999) / 1000000;
+    DWORD milliseconds = timeout == IDLE_WAIT_FOREVER ? INFINITE : (DWORD)(rounded < INFINITE - 1 ? rounded : INFINITE - 1); // Long timeouts must not become INFINITE
+    // MWMO_INPUTAVAILABLE: also return for input already in the queue (seen but not removed by an earlier PeekMessage)
+    DWORD result = ctx->window
+        ? MsgWaitForMultipleObjectsEx(1, &ctx->wakeEvent, milliseconds, QS_ALLINPUT, MWMO_INPUTAVAILABLE)
+        : WaitForSingleObject(ctx->wakeEvent, milliseconds);
+    return result == WAIT_OBJECT_0;
+#else
+    pthread_mutex_lock(&ctx->wakeLock);
+    if (timeout == IDLE_WAIT_FOREVER) {
+        while (!ctx->wakeRequested) pthread_cond_wait(&ctx->wakeCondition, &ctx->wakeLock);
+    }
+    else if (timeout) {
+        uint64 deadline = EW32_profileNow() + timeout;
+        struct timespec ts = { .tv_sec = deadline / 1000000000ull, .tv_nsec = deadline % 1000000000ull };
+        while (!ctx->wakeRequested) {
+            if (pthread_cond_timedwait(&ctx->wakeCondition, &ctx->wakeLock, &ts) == ETIMEDOUT) break;
+        }
+    }
+    bool requested = ctx->wakeRequested;
+    ctx->wakeRequested = false;
+    pthread_mutex_unlock(&ctx->wakeLock);
+    return requested;
+#endif
+}
 
-        TranslateMessage(&msg);
-        DispatchMessageA(&msg);
+void EW32_RequestRedrawCtx(ew32_context* ctx) {
+#ifdef _WIN32
+    SetEvent(ctx->wakeEvent);
+#else
+    pthread_mutex_lock(&ctx->wakeLock);
+    ctx->wakeRequested = true;
+    pthread_cond_signal(&ctx->wakeCondition);
+    pthread_mutex_unlock(&ctx->wakeLock);
+#endif
+}
+void EW32_RequestRedrawInCtx(ew32_context* ctx, double delay) {
+    uint64 deadline = EW32_profileNow() + (uint64)(delay > 0.0 ? delay * 1e9 : 0.0);
+    if (!ctx->redrawDeadline || deadline < ctx->redrawDeadline) ctx->redrawDeadline = deadline;
+}
+bool EW32_ShouldRedrawCtx(ew32_context* ctx) {
+    return ctx->needsRedraw;
+}
+
+void EW32_StartFrameCtx(ew32_context* ctx) {
+    EW32_PROFILE_BEGIN("EW32_StartFrame");
+
+    // In idle mode, sleep until there is something to do
+    uint64 now = EW32_profileNow(), timeout = 0;
+    bool pending = ctx->inputEvent || ctx->time.frameCount == 0 || (ctx->redrawDeadline && now >= ctx->redrawDeadline);
+    if (ctx->idleWait && !pending) {
+        timeout = ctx->idleMaxWait > 0.0 ? (uint64)(ctx->idleMaxWait * 1e9) : IDLE_WAIT_FOREVER;
+        if (ctx->redrawDeadline && ctx->redrawDeadline - now < timeout) timeout = ctx->redrawDeadline - now;
+    }
+    EW32_PROFILE_BEGIN("EW32_IdleWait");
+    bool requested = easyWIN32_WaitForWake(ctx, timeout);
+    EW32_PROFILE_END();
+
+    EW32_PROFILE_BEGIN("EW32_InputPump");
+#ifdef _WIN32
+    if (ctx->window) {
+        // Pump every window of the thread (other contexts, IME, COM...): "easyWIN32_WindowProc" routes each message to its own context
+        MSG msg = {0};
+        while (PeekMessage(&msg, NULL, 0, 0, PM_REMOVE)) {
+            if (msg.message == WM_QUIT) EW32_SetShouldCloseCtx(ctx, true);
+
+            TranslateMessage(&msg);
+            DispatchMessageA(&msg);
+        }
     }
-    easyWIN32_UpdateInputState();
+#endif
+    EW32_PROFILE_END();
+
+    bool timerFired = ctx->redrawDeadline && EW32_profileNow() >= ctx->redrawDeadline;
+    if (timerFired) ctx->redrawDeadline = 0;
+    ctx->needsRedraw = requested || timerFired || (ctx->idleWait ? ctx->inputEvent || ctx->time.frameCount == 0 : ctx->alwaysRedrawframe);
+    ctx->inputEvent = false;
+
+    easyWIN32_UpdateInputState(ctx);
+    EW32_PROFILE_END();
 }
 
-void EW32_EndFrame() {
-    if (MAIN_W32.alwaysRedrawframe) {
-        InvalidateRect(MAIN_W32.window, NULL, FALSE);
-        UpdateWindow(MAIN_W32.window);
+void EW32_EndFrameCtx(ew32_context* ctx) {
+    EW32_PROFILE_BEGIN("EW32_EndFrame");
+    if (ctx->needsRedraw) {
+        EW32_PROFILE_BEGIN("EW32_Present");
+#ifdef _WIN32
+        if (ctx->window) {
+            InvalidateRect(ctx->window, NULL, FALSE);
+            UpdateWindow(ctx->window);
+        }
+        else easyWIN32_ResolveBackbuffer(ctx);
+#else
+        easyWIN32_ResolveBackbuffer(ctx);
+#endif
+        EW32_PROFILE_END();
     }
 
     struct timeval tv;
     gettimeofday(&tv, NULL);
-    double newTime = tv.tv_sec + tv.tv_usec * 1e-6 - MAIN_W32.time.appStartDate;
-    MAIN_W32.time.dt = newTime - MAIN_W32.time.timeAtFrameStart;
-    MAIN_W32.time.timeAtFrameStart = newTime;
-    MAIN_W32.time.lastDts[MAIN_W32.time.lastDtIndex = (MAIN_W32.time.lastDtIndex + 1) % NB_SMOOTH_DT] = MAIN_W32.time.dt;
-    MAIN_W32.time.smoothDt = 0.0; for (uint i = 0; i < NB_SMOOTH_DT; ++i) MAIN_W32.time.smoothDt += MAIN_W32.time.lastDts[i]; MAIN_W32.time.smoothDt /= NB_SMOOTH_DT;
-    ++MAIN_W32.time.frameCount;
-}
\ No newline at end of file
+    double newTime = tv.tv_sec + tv.tv_usec * 1e-6 - ctx->time.appStartDate;
+    ctx->time.dt = newTime - ctx->time.timeAtFrameStart;
+    ctx->time.timeAtFrameStart = newTime;
+    ctx->time.lastDts[ctx->time.lastDtIndex = (ctx->time.lastDtIndex + 1) % NB_SMOOTH_DT] = ctx->time.dt;
+    ctx->time.smoothDt = 0.0; for (uint i = 0; i < NB_SMOOTH_DT; ++i) ctx->time.smoothDt += ctx->time.lastDts[i]; ctx->time.smoothDt /= NB_SMOOTH_DT;
+    ++ctx->time.frameCount;
+    easyWIN32_UpdateFixedStep(&ctx->time);
+    EW32_PROFILE_END();
+
+    EW32_PROFILE_FRAME();
+}
+///// DEFAULT CONTEXT
+
+void EW32_Initilize(char* windowName, ew32_init_params params) {
+    EW32_contextDestroy(DEFAULT_CONTEXT);
+    DEFAULT_CONTEXT = EW32_contextCreate(windowName, params);
+    if (!DEFAULT_CONTEXT) exit(0); // wParam for exiting the app before statring the message loop
+}
+
+void EW32_StartFrame() { EW32_StartFrameCtx(DEFAULT_CONTEXT); }
+void EW32_EndFrame() { EW32_EndFrameCtx(DEFAULT_CONTEXT); }
+bool EW32_ShouldClose() { return EW32_ShouldCloseCtx(DEFAULT_CONTEXT); }
+void EW32_SetShouldClose(bool value) { EW32_SetShouldCloseCtx(DEFAULT_CONTEXT, value); }
+void EW32_RequestRedraw() { EW32_RequestRedrawCtx(DEFAULT_CONTEXT); }
+void EW32_RequestRedrawIn(double delay) { EW32_RequestRedrawInCtx(DEFAULT_CONTEXT, delay); }
+bool EW32_ShouldRedraw() { return EW32_ShouldRedrawCtx(DEFAULT_CONTEXT); }
+
+ew32_texture* EW32_textureGet() { return EW32_textureGetCtx(DEFAULT_CONTEXT); }
+void EW32_textureSet(ew32_texture texture) { EW32_textureSetCtx(DEFAULT_CONTEXT, texture); }
+void EW32_textureSetPalette(const uint32* palette) { EW32_textureSetPaletteCtx(DEFAULT_CONTEXT, palette); }
+void EW32_windowGetSize(uint* x, uint* y) { EW32_windowGetSizeCtx(DEFAULT_CONTEXT, x, y); }
+
+double EW32_timeDelta() { return EW32_timeDeltaCtx(DEFAULT_CONTEXT); }
+double EW32_timeSmoothDelta() { return EW32_timeSmoothDeltaCtx(DEFAULT_CONTEXT); }
+double EW32_timeAtFrameStart() { return EW32_timeAtFrameStartCtx(DEFAULT_CONTEXT); }
+uint64 EW32_timeFrameCount() { return EW32_timeFrameCountCtx(DEFAULT_CONTEXT); }
+bool EW32_timeTick() { return EW32_timeTickCtx(DEFAULT_CONTEXT); }
+double EW32_timeTickDelta() { return EW32_timeTickDeltaCtx(DEFAULT_CONTEXT); }
+uint64 EW32_timeTickCount() { return EW32_timeTickCountCtx(DEFAULT_CONTEXT); }
+double EW32_timeAlpha() { return EW32_timeAlphaCtx(DEFAULT_CONTEXT); }
+double EW32_timeDropped() { return EW32_timeDroppedCtx(DEFAULT_CONTEXT); }
+
+ew32_input_state EW32_inputGetKeyState(ew32_key key) { return EW32_inputGetKeyStateCtx(DEFAULT_CONTEXT, key); }
+ew32_input_snapshot EW32_inputGetSnapshot() { return EW32_inputGetSnapshotCtx(DEFAULT_CONTEXT); }
+void EW32_inputSimulateKey(ew32_key key, bool down) { EW32_inputSimulateKeyCtx(DEFAULT_CONTEXT, key, down); }
@@ -38,10 +38,10 @@ typedef void (func_WM_PAINT_CALLBACK)(void* paintStruct, void* hdc);
 /// @brief Input state of an EasyWIN32 tracked key
 typedef enum EasyWIN32_InputState {
     EW32_INPUT_DOWN         = 0x0001, /// @brief If the key is currently down      
-    EW32_INPUT_PRESSED      = 0x0003, /// @brief If the key has just been pressed
+    EW32_INPUT_PRESSED      = 0x0002, /// @brief If the key went down during the last frame (it may be up again)
 
     EW32_INPUT_UP           = 0x0004, /// @brief If the key is currently up    
-    EW32_INPUT_RELEASED     = 0x000C, /// @brief If the key has just been released
+    EW32_INPUT_RELEASED     = 0x0008, /// @brief If the key went up during the last frame (it may be down again)
     
     EW32_INPUT_REPEAT       = 0x0010, /// @brief If the key is curretly repeating    
     EW32_INPUT_DOUBLE_CLICK = 0x0020, /// @brief If the key is the result of a double click
@@ -107,13 +107,16 @@ typedef enum EasyWIN32_Key {
     EW32_KEY_CTRL,
     EW32_KEY_CTRL_R,
     EW32_KEY_CTRL_L,
+
+    EW32_KEY_COUNT /// @brief Number of key values, not a key
 } ew32_key;
 /// @brief The structure of a texture to blit onto the screen
 typedef struct EasyWIN32_Texture {
     int width, height;
-    int bitDepth; // Number of bits per pixel
+    int bitDepth; // Number of bits per pixel (8 bits textures are indices into the palette)
     uint8* buffer;
 } ew32_texture;
+#define EW32_PALETTE_SIZE 256 // Number of colors in the palette of 8 bits textures
 
 
 
@@ -124,6 +127,11 @@ typedef struct EW32_InitializationParameters {
     bool doDoubleClick;
     bool doAlwaysRedrawFrame;
     bool doBilinearInterpolation;
+    bool doHeadless; // No window: frames are only resolved in memory (always the case without Win32)
+    bool doIdleWait; // "EW32_StartFrame" sleeps until input, a redraw request or a timer, and frames are only presented on demand
+    double idleMaxWait; // Maximum time (in seconds) slept by "EW32_StartFrame" in idle mode, no limit if <= 0
+    double tickRate; // Fixed simulation steps per second (see "EW32_timeTick"), 0 to disable
+    uint maxTicksPerFrame; // Maximum number of fixed steps run in a frame, time beyond is dropped (0 for the default of 8)
     func_WM_PAINT_CALLBACK* wmPaintCallback;
 } ew32_init_params;
 /// @brief Get the default parameters for initializing the EasyWIN32 window
@@ -133,6 +141,7 @@ ew32_init_params EW32_GetDefaultInitParams();
 /// @param windowName The name of the window
 /// @param params The initialization parameters
 /// @note You can get the "default parameters" by calling "EW32_GetDefaultInitParams()"
+/// @note This creates the default context, used by every function without a "Ctx" suffix
 void EW32_Initilize(char* windowName, ew32_init_params params);
 
 /// @brief Wether the EasyWIN32 window should close (for example when the user presses the [X] button at the top right)
@@ -142,6 +151,17 @@ bool EW32_ShouldClose();
 /// @param value The state to assign
 void EW32_SetShouldClose(bool value);
 
+/// @brief Ask for the next frame to be presented, waking up "EW32_StartFrame" if it is waiting in idle mode
+/// @note This is the only function that can be called from any thread
+void EW32_RequestRedraw();
+/// @brief Ask for a frame to be presented after a delay (for example for animations or a blinking cursor in idle mode)
+/// @param delay The delay in seconds (only the earliest pending request is kept)
+void EW32_RequestRedrawIn(double delay);
+/// @brief Wether the current frame will be presented by "EW32_EndFrame"
+/// @return Wether the frame should be drawn
+/// @note Always true when "doAlwaysRedrawFrame" is set outside of idle mode. In idle mode, true after input, a redraw request or a timer
+bool EW32_ShouldRedraw();
+
 /// @brief Get the texture used for rendering onto the screen
 /// @return The texture
 /// @note If you want to change the size of the texture, use "EW32_SetTexture" with the changed size
@@ -149,6 +169,10 @@ ew32_texture* EW32_textureGet();
 /// @brief Replace the old render texture for a new one
 /// @param texture The new texture to use
 void EW32_textureSet(ew32_texture texture);
+/// @brief Set the palette used to present 8 bits textures
+/// @param palette The "EW32_PALETTE_SIZE" colors (packed with "EW32_PACK_RGB")
+/// @note The palette defaults to a grayscale ramp
+void EW32_textureSetPalette(const uint32* palette);
 
 // void EW32_WindowSetFullScreen();
 // void EW32_WindowMinimize();
@@ -159,6 +183,7 @@ void EW32_windowGetSize(uint* x, uint* y);
 // void EW32_WindowSetSize();
 
 /// @brief Start the frame (and set internal variables)
+/// @note In idle mode, this blocks until input arrives, a redraw is requested or "idleMaxWait" runs out
 void EW32_StartFrame();
 /// @brief End the frame (and set internal variables)
 void EW32_EndFrame();
@@ -178,12 +203,80 @@ double EW32_timeAtFrameStart();
 /// @return The number of rendered frames
 uint64 EW32_timeFrameCount();
 
+// Fixed-step simulation: each frame, run the steps due so far, then render the state interpolated by "EW32_timeAlpha"
+//     while (EW32_timeTick()) simulate(EW32_timeTickDelta());
+//     render(EW32_timeAlpha());
+
+/// @brief Consume one of the fixed steps due this frame
+/// @return Wether a step should be simulated (false once every step due this frame ran)
+/// @note At most "maxTicksPerFrame" steps are due per frame, so a hitch never causes an ever growing catch-up
+bool EW32_timeTick();
+/// @brief Get the duration of a fixed step
+/// @return "1 / tickRate" (in seconds), 0 if fixed steps are disabled
+double EW32_timeTickDelta();
+/// @brief Get the number of fixed steps simulated so far
+/// @return The number of fixed steps
+uint64 EW32_timeTickCount();
+/// @brief Get how far the current time is between the last two fixed steps, to interpolate their states when rendering
+/// @return The interpolation factor in [0, 1] (1 if fixed steps are disabled)
+double EW32_timeAlpha();
+/// @brief Get the total time dropped because more than "maxTicksPerFrame" steps were due
+/// @return The dropped time (in seconds)
+double EW32_timeDropped();
+
 ///// INPUT
 
+#define EW32_INPUT_NB_KEYS 256 // Number of key indices (Win32 virtual key codes)
+#define EW32_KEY_SET_WORDS (EW32_INPUT_NB_KEYS / 64)
+/// @brief A set of keys, one bit per key index
+typedef struct EasyWIN32_KeySet {
+    uint64 bits[EW32_KEY_SET_WORDS];
+} ew32_key_set;
+/// @brief The whole input state of a frame
+typedef struct EasyWIN32_InputSnapshot {
+    ew32_key_set down;        // Keys currently down
+    ew32_key_set pressed;     // Keys that went down during the last frame
+    ew32_key_set released;    // Keys that went up during the last frame
+    ew32_key_set repeat;      // Keys currently repeating
+    ew32_key_set doubleClick; // Keys that were double clicked during the last frame
+    int mouseX, mouseY, scroll;
+} ew32_input_snapshot;
+
+/// @brief Get the index of a key in key sets
+/// @param key The key
+/// @return The index, or 0 if the key is not assigned
+/// @note Resolve the indices of your bindings once, then test them against snapshots
+int EW32_inputKeyIndex(ew32_key key);
+/// @brief Check wether a key set contains a key
+/// @param set The set to query
+/// @param index The index of the key (from "EW32_inputKeyIndex")
+/// @return Wether the key is in the set
+static inline bool EW32_keySetHas(const ew32_key_set* set, int index) { return (set->bits[(index >> 6) & (EW32_KEY_SET_WORDS - 1)] >> (index & 63)) & 1; }
+/// @brief Get the state of a key from a snapshot
+/// @param snapshot The snapshot to query
+/// @param index The index of the key (from "EW32_inputKeyIndex")
+/// @return The state of the key
+static inline ew32_input_state EW32_snapshotGetKeyState(const ew32_input_snapshot* snapshot, int index) {
+    ew32_input_state state = EW32_keySetHas(&snapshot->down, index) ? EW32_INPUT_DOWN : EW32_INPUT_UP;
+    if (EW32_keySetHas(&snapshot->pressed, index))     state |= EW32_INPUT_PRESSED;
+    if (EW32_keySetHas(&snapshot->released, index))    state |= EW32_INPUT_RELEASED;
+    if (EW32_keySetHas(&snapshot->repeat, index))      state |= EW32_INPUT_REPEAT;
+    if (EW32_keySetHas(&snapshot->doubleClick, index)) state |= EW32_INPUT_DOUBLE_CLICK;
+    return state;
+}
+/// @brief Get the whole input state of the current frame at once
+/// @return The snapshot (computed during "EW32_StartFrame")
+ew32_input_snapshot EW32_inputGetSnapshot();
+
 /// @brief Get the state of a key
 /// @param key The key to query
 /// @return The state of the key
 ew32_input_state EW32_inputGetKeyState(ew32_key key);
+/// @brief Feed a key event to the input state as if it came from the window
+/// @param key The key to change
+/// @param down Wether the key is now down
+/// @note Mostly useful for the headless backend (benchmarks, replays, tests)
+void EW32_inputSimulateKey(ew32_key key, bool down);
 /// @brief Check wether a key has a certain state
 /// @param key The key to query
 /// @param state The states to check (states can be binary-or-ed together to check for multiple states)
@@ -200,7 +293,7 @@ static inline bool EW32_inputIsKeyPressed(ew32_key key)                  { retur
 /// @brief Check wether a key is currently up
 /// @param key The key to query
 /// @return Wether the key is curretly up
-static inline bool EW32_inputIsKeyUp(ew32_key key)                       { return  EW32_inputIsKey(key, EW32_INPUT_DOWN);         }
+static inline bool EW32_inputIsKeyUp(ew32_key key)                       { return  EW32_inputIsKey(key, EW32_INPUT_UP);           }
 /// @brief Check wether a key has just been released
 /// @param key The key to query
 /// @return Wether the key has just been released
@@ -214,4 +307,274 @@ static inline bool EW32_inputIsKeyRepeat(ew32_key key)                   { retur
 /// @return Wether the key is the result of a double click
 static inline bool EW32_inputIsKeyDoubleClick(ew32_key key)              { return  EW32_inputIsKey(key, EW32_INPUT_DOUBLE_CLICK); }
 
-#endif
\ No newline at end of file
+///// CONTEXTS
+
+// A context owns a window (or none when headless) with its render texture, input and time.
+// Every function above has a "Ctx" variant working on an explicit context, so several windows or headless renderers can coexist.
+// A context is not thread safe: use each one from a single thread at a time (on Win32, the thread that created it). Only "EW32_RequestRedrawCtx" can be called from anywhere.
+
+/// @brief An EasyWIN32 window and its state
+typedef struct EasyWIN32_Context ew32_context;
+
+/// @brief Create a new context
+/// @param windowName The name of the window (must outlive the context)
+/// @param params The initialization parameters
+/// @return The context, or NULL if it could not be created
+ew32_context* EW32_contextCreate(const char* windowName, ew32_init_params params);
+/// @brief Destroy a context, its window and its render texture
+/// @param context The context to destroy (can be NULL)
+void EW32_contextDestroy(ew32_context* context);
+/// @brief Get the context created by "EW32_Initilize"
+/// @return The default context, or NULL if there is none
+ew32_context* EW32_contextGetDefault();
+
+/// @brief Same as "EW32_StartFrame", on a given context
+void EW32_StartFrameCtx(ew32_context* context);
+/// @brief Same as "EW32_EndFrame", on a given context
+void EW32_EndFrameCtx(ew32_context* context);
+/// @brief Same as "EW32_ShouldClose", on a given context
+bool EW32_ShouldCloseCtx(ew32_context* context);
+/// @brief Same as "EW32_SetShouldClose", on a given context
+void EW32_SetShouldCloseCtx(ew32_context* context, bool value);
+/// @brief Same as "EW32_RequestRedraw", on a given context
+void EW32_RequestRedrawCtx(ew32_context* context);
+/// @brief Same as "EW32_RequestRedrawIn", on a given context
+void EW32_RequestRedrawInCtx(ew32_context* context, double delay);
+/// @brief Same as "EW32_ShouldRedraw", on a given context
+bool EW32_ShouldRedrawCtx(ew32_context* context);
+
+/// @brief Same as "EW32_textureGet", on a given context
+ew32_texture* EW32_textureGetCtx(ew32_context* context);
+/// @brief Same as "EW32_textureSet", on a given context
+void EW32_textureSetCtx(ew32_context* context, ew32_texture texture);
+/// @brief Same as "EW32_textureSetPalette", on a given context
+void EW32_textureSetPaletteCtx(ew32_context* context, const uint32* palette);
+/// @brief Same as "EW32_windowGetSize", on a given context
+void EW32_windowGetSizeCtx(ew32_context* context, uint* x, uint* y);
+
+/// @brief Same as "EW32_timeDelta", on a given context
+double EW32_timeDeltaCtx(ew32_context* context);
+/// @brief Same as "EW32_timeSmoothDelta", on a given context
+double EW32_timeSmoothDeltaCtx(ew32_context* context);
+/// @brief Same as "EW32_timeAtFrameStart", on a given context
+double EW32_timeAtFrameStartCtx(ew32_context* context);
+/// @brief Same as "EW32_timeFrameCount", on a given context
+uint64 EW32_timeFrameCountCtx(ew32_context* context);
+/// @brief Same as "EW32_timeTick", on a given context
+bool EW32_timeTickCtx(ew32_context* context);
+/// @brief Same as "EW32_timeTickDelta", on a given context
+double EW32_timeTickDeltaCtx(ew32_context* context);
+/// @brief Same as "EW32_timeTickCount", on a given context
+uint64 EW32_timeTickCountCtx(ew32_context* context);
+/// @brief Same as "EW32_timeAlpha", on a given context
+double EW32_timeAlphaCtx(ew32_context* context);
+/// @brief Same as "EW32_timeDropped", on a given context
+double EW32_timeDroppedCtx(ew32_context* context);
+
+/// @brief Same as "EW32_inputGetKeyState", on a given context
+ew32_input_state EW32_inputGetKeyStateCtx(ew32_context* context, ew32_key key);
+/// @brief Same as "EW32_inputGetSnapshot", on a given context
+ew32_input_snapshot EW32_inputGetSnapshotCtx(ew32_context* context);
+/// @brief Same as "EW32_inputSimulateKey", on a given context
+/// @note Like the rest of the context, only call it from the thread driving the context (use "EW32_RequestRedrawCtx" to wake it from others)
+void EW32_inputSimulateKeyCtx(ew32_context* context, ew32_key key, bool down);
+
+///// PROFILING
+
+// Define EW32_PROFILE (for the library and the application) to enable profiling zones.
+// When it is not defined, the zone macros compile out entirely.
+
+// Each thread that profiles allocates a ring of EW32_PROFILE_RING_SIZE events (16 bytes each, 1 MiB by default).
+// Rings are never freed: threads that exit should call "EW32_PROFILE_THREAD_RELEASE" so that new threads reuse their ring.
+#ifndef EW32_PROFILE_RING_SIZE
+#   define EW32_PROFILE_RING_SIZE (1 << 16) // Number of events kept per thread (must be a power of 2)
+#endif
+#define EW32_PROFILE_MAX_ZONES 64 // Maximum number of distinct zones in a frame summary
+
+#ifdef EW32_PROFILE
+/// @brief Open a profiling zone on the calling thread
+/// @param name The name of the zone (must be a string literal or outlive the profiler)
+#   define EW32_PROFILE_BEGIN(name) EW32_profileBegin(name)
+/// @brief Close the last opened profiling zone on the calling thread
+#   define EW32_PROFILE_END() EW32_profileEnd()
+/// @brief Mark the end of a frame and compute the per-frame zone summary
+#   define EW32_PROFILE_FRAME() EW32_profileFrameMark()
+/// @brief Hand the ring of the calling thread over to the next new profiling thread (call it before the thread exits)
+#   define EW32_PROFILE_THREAD_RELEASE() EW32_profileThreadRelease()
+#else
+#   define EW32_PROFILE_BEGIN(name) ((void)0)
+#   define EW32_PROFILE_END() ((void)0)
+#   define EW32_PROFILE_FRAME() ((void)0)
+#   define EW32_PROFILE_THREAD_RELEASE() ((void)0)
+#endif
+
+/// @brief Accumulated timings of a zone over one frame
+typedef struct EasyWIN32_ProfileZoneStat {
+    const char* name;
+    double totalTime; // Total time spent in the zone (in seconds)
+    double maxTime; // Longest single occurence of the zone (in seconds)
+    uint count; // Number of times the zone was entered
+} ew32_profile_zone_stat;
+
+/// @brief Get the current value of the profiler clock
+/// @return A monotonic timestamp in nanoseconds
+uint64 EW32_profileNow();
+/// @brief Open a profiling zone on the calling thread (prefer "EW32_PROFILE_BEGIN")
+/// @param name The name of the zone
+void EW32_profileBegin(const char* name);
+/// @brief Close the last opened profiling zone on the calling thread (prefer "EW32_PROFILE_END")
+void EW32_profileEnd();
+/// @brief Hand the ring of the calling thread over to the next new profiling thread (prefer "EW32_PROFILE_THREAD_RELEASE")
+/// @note Its events stay exportable until the new thread overwrites them, under the thread id of the ring's first thread
+void EW32_profileThreadRelease();
+/// @brief Mark the end of a frame on the calling thread (prefer "EW32_PROFILE_FRAME")
+/// @note Called by "EW32_EndFrame" when profiling is enabled
+void EW32_profileFrameMark();
+/// @brief Get the zone summary of the last frame completed on the calling thread (zones are counted in the frame they close in)
+/// @param stats The array to fill
+/// @param maxCount The size of the array
+/// @return The number of zones written
+uint EW32_profileFrameSummary(ew32_profile_zone_stat* stats, uint maxCount);
+/// @brief Print the zone summary of the last frame completed on the calling thread
+/// @param file The file to print to (for example "stdout")
+void EW32_profilePrintFrameSummary(FILE* file);
+/// @brief Export every recorded event of every thread in the Chrome "trace_event" JSON format
+/// @param path The path of the file to write
+/// @return Wether the file could be written
+/// @note The result can be opened with "chrome://tracing" or "ui.perfetto.dev"
+/// @note Other threads may keep profiling during the export: their events overwritten while the export copies them are left out
+bool EW32_profileExportChromeTrace(const char* path);
+
+///// PIXEL PIPELINES
+
+/// @brief Pixel formats with specialized kernels
+typedef enum EasyWIN32_PixelFormat {
+    EW32_FORMAT_INDEXED8, /// @brief 8 bits palette indices
+    EW32_FORMAT_RGB32,    /// @brief 32 bits colors packed with "EW32_PACK_RGB"
+    EW32_FORMAT_COUNT
+} ew32_pixel_format;
+/// @brief Filters used when scaling
+typedef enum EasyWIN32_Filter {
+    EW32_FILTER_NEAREST,
+    EW32_FILTER_BILINEAR, /// @brief Falls back to nearest for "EW32_FORMAT_INDEXED8"
+    EW32_FILTER_COUNT
+} ew32_filter;
+/// @brief How source pixels are written over destination pixels
+typedef enum EasyWIN32_Blend {
+    EW32_BLEND_COPY,  /// @brief Always overwrite
+    EW32_BLEND_KEYED, /// @brief Skip source pixels equal to the key (transparent color)
+    EW32_BLEND_COUNT
+} ew32_blend;
+
+/// @brief A function type for filling a span of pixels with one value
+typedef void (func_EW32_PIXEL_FILL)(void* dst, uint count, uint32 value);
+/// @brief A function type for copying a span of pixels
+typedef void (func_EW32_PIXEL_BLIT)(void* dst, const void* src, uint count, uint32 key);
+/// @brief A function type for scaling a whole texture into another of the same format
+typedef void (func_EW32_PIXEL_SCALE)(ew32_texture* dst, const ew32_texture* src, uint32 key);
+/// @brief A function type for expanding a texture to 32 bits colors
+typedef void (func_EW32_PIXEL_EXPAND)(uint32* dst, const uint8* src, uint count, const uint32* palette);
+
+/// @brief The set of kernels specialized for one {format, filter, blend}
+typedef struct EasyWIN32_PixelPipeline {
+    ew32_pixel_format format;
+    ew32_filter filter;
+    ew32_blend blend;
+
+    func_EW32_PIXEL_FILL* fill;
+    func_EW32_PIXEL_BLIT* blit;
+    func_EW32_PIXEL_SCALE* scale;
+    func_EW32_PIXEL_EXPAND* expand; // NULL when the format is presented as is
+} ew32_pixel_pipeline;
+
+/// @brief Get the pixel format matching a texture bit depth
+/// @param bitDepth The number of bits per pixel
+/// @return The format, or "EW32_FORMAT_COUNT" if there are no kernels for this depth
+ew32_pixel_format EW32_pixelFormatFromBitDepth(int bitDepth);
+/// @brief Get the kernels specialized for a combination of format, filter and blend mode
+/// @return The pipeline, or NULL if one of the parameters is out of range
+/// @note Look the pipeline up once (when the texture or parameters change) and keep the pointer
+const ew32_pixel_pipeline* EW32_pixelPipelineGet(ew32_pixel_format format, ew32_filter filter, ew32_blend blend);
+/// @brief Expand palette indices into 32 bits colors (done once per present for 8 bits textures)
+/// @param dst The 32 bits pixels to write
+/// @param src The palette indices to read
+/// @param count The number of pixels
+/// @param palette The "EW32_PALETTE_SIZE" colors
+void EW32_textureExpandIndexed(uint32* dst, const uint8* src, uint count, const uint32* palette);
+
+///// TEXTURE CACHE
+
+// Textures are baked with their mip levels into an asset file, which the cache maps in memory.
+// Levels are copied ("paged in") to resident memory on demand, within a fixed budget, and the least recently used ones are evicted.
+// A level that is not resident is only queued on a miss: it is paged in by the next "EW32_textureCacheBeginFrame",
+// and the finest resident coarser level is used meanwhile. Resident memory never exceeds the budget, whatever the size of the asset file.
+
+/// @brief A texture cache streaming from an asset file
+typedef struct EasyWIN32_TextureCache ew32_texture_cache;
+/// @brief Counters of a texture cache
+typedef struct EasyWIN32_TextureCacheStats {
+    uint64 hits;      // Requests served by the wanted level
+    uint64 misses;    // Requests for a level that was not resident
+    uint64 loads;     // Levels paged in
+    uint64 evictions; // Levels evicted to make room
+    uint64 residentBytes, budgetBytes;
+} ew32_texture_cache_stats;
+
+/// @brief Bake textures and their mip levels into an asset file for "EW32_textureCacheCreate"
+/// @param path The path of the file to write
+/// @param textures The textures (8 or 32 bits), their index is their id in the cache
+/// @param count The number of textures
+/// @param doMipmaps Wether to generate the mip levels (down to 1x1)
+/// @return Wether the file could be written (on failure, no partial file is left behind)
+/// @note 32 bits levels are box filtered, 8 bits levels are point sampled (indices can not be averaged)
+bool EW32_textureAssetWrite(const char* path, const ew32_texture* textures, uint count, bool doMipmaps);
+/// @brief Check wether an asset file was baked from these textures, to skip baking it again
+/// @param path The path of the asset file
+/// @param textures The textures that would be given to "EW32_textureAssetWrite"
+/// @param count The number of textures
+/// @param doMipmaps Wether the mip levels would be generated
+/// @return Wether the file exists and matches the textures (false if it is missing or stale)
+/// @note Only the file header is read: the match is based on a checksum of the textures
+bool EW32_textureAssetIsCurrent(const char* path, const ew32_texture* textures, uint count, bool doMipmaps);
+
+/// @brief Open an asset file as a texture cache
+/// @param path The asset file (from "EW32_textureAssetWrite")
+/// @param budgetBytes The maximum number of bytes of resident texels
+/// @return The cache, or NULL if the file could not be opened
+/// @note The whole file is mapped: 32 bits builds can only open files that fit in their address space (in practice, under 1 or 2 GiB)
+ew32_texture_cache* EW32_textureCacheCreate(const char* path, uint64 budgetBytes);
+/// @brief Close a texture cache and free every resident level
+/// @param cache The cache to destroy (can be NULL)
+void EW32_textureCacheDestroy(ew32_texture_cache* cache);
+/// @brief Start a new frame: page in the levels missed during the last frame
+/// @param cache The cache
+/// @note Textures returned during the previous frame may be evicted, and must be requested again
+void EW32_textureCacheBeginFrame(ew32_texture_cache* cache);
+/// @brief Get a mip level of a texture
+/// @param cache The cache
+/// @param id The index of the texture in the asset file
+/// @param level The wanted mip level (0 is the full size)
+/// @return The wanted level if resident, else the finest resident coarser one (NULL if none fits in the budget)
+/// @note The returned texture stays valid until the next "EW32_textureCacheBeginFrame"
+const ew32_texture* EW32_textureCacheGet(ew32_texture_cache* cache, uint id, uint level);
+/// @brief Get the number of textures in the asset file
+/// @param cache The cache
+/// @return The number of textures
+uint EW32_textureCacheCount(const ew32_texture_cache* cache);
+/// @brief Get the size of a texture and its number of mip levels, without paging it in
+/// @param cache The cache
+/// @param id The index of the texture in the asset file
+/// @param width The width of level 0 (can be NULL)
+/// @param height The height of level 0 (can be NULL)
+/// @param nbLevels The number of mip levels (can be NULL)
+/// @return Wether the id is valid
+bool EW32_textureCacheInfo(const ew32_texture_cache* cache, uint id, uint* width, uint* height, uint* nbLevels);
+/// @brief Get the counters of a cache
+/// @param cache The cache
+/// @return The counters
+ew32_texture_cache_stats EW32_textureCacheGetStats(const ew32_texture_cache* cache);
+/// @brief Reset the hit, miss, load and eviction counters of a cache
+/// @param cache The cache
+void EW32_textureCacheResetStats(ew32_texture_cache* cache);
+
+#endif
@@ -0,0 +1,458 @@
+#ifndef _WIN32
+#   define _FILE_OFFSET_BITS 64 // 64 bits "off_t" for "fseeko", even in 32 bits builds
+#endif
+
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#ifdef _WIN32
+#   include <windows.h>
+#else
+#   include <sys/types.h>
+#   include <fcntl.h>
+#   include <unistd.h>
+#   include <sys/mman.h>
+#   include <sys/stat.h>
+#endif
+
+#include "easyWIN32.h"
+
+///// ASSET FILE
+
+// Layout: header, one "asset_texture" per texture, then the levels of every texture (finest first, each one right after the other)
+#define ASSET_MAGIC 0x54323345 // "E32T"
+#define ASSET_VERSION 2
+#define ASSET_ALIGNMENT 64 // Alignment of the texels of each texture in the file
+#define ASSET_MAX_SIZE 65536 // Maximum width or height of a texture
+
+typedef struct AssetHeader {
+    uint32 magic, version;
+    uint32 nbTextures, checksum; // Of the source textures, to know when the file is stale
+} asset_header;
+
+typedef struct AssetTexture {
+    uint32 width, height;
+    uint32 bitDepth, nbLevels;
+    uint64 offset; // Of level 0, from the start of the file
+} asset_texture;
+
+// "fseek" takes a "long", which is 32 bits on Win64
+static inline bool easyWIN32_FileSeek(FILE* file, uint64 offset) {
+#ifdef _WIN32
+    return _fseeki64(file, (long long)offset, SEEK_SET) == 0;
+#else
+    return fseeko(file, (off_t)offset, SEEK_SET) == 0;
+#endif
+}
+
+static inline uint easyWIN32_LevelDim(uint size, uint level) {
+    size >>= level;
+    return size ? size : 1;
+}
+static inline uint64 easyWIN32_LevelBytes(uint width, uint height, uint bitDepth, uint level) {
+    return (uint64)easyWIN32_LevelDim(width, level) * easyWIN32_LevelDim(height, level) * (bitDepth / 8);
+}
+static uint easyWIN32_CountLevels(uint width, uint height) {
+    uint nbLevels = 1;
+    while ((width | height) >> nbLevels) nbLevels++;
+    return nbLevels;
+}
+
+// Compute the next mip level: 2x2 box filter for colors, point sampling for palette indices
+static void easyWIN32_Downsample(uint8* dst, const uint8* src, uint srcWidth, uint srcHeight, uint bitDepth) {
+    uint width = easyWIN32_LevelDim(srcWidth, 1), height = easyWIN32_LevelDim(srcHeight, 1);
+    for (uint y = 0; y < height; ++y) {
+        uint y0 = 2 * y, y1 = 2 * y + 1 < srcHeight ? 2 * y + 1 : y0;
+        for (uint x = 0; x < width; ++x) {
+            uint x0 = 2 * x, x1 = 2 * x + 1 < srcWidth ? 2 * x + 1 : x0;
+            if (bitDepth == 8) {
+                dst[x + y * width] = src[x0 + y0 * srcWidth];
+                continue;
+            }
+
+            const uint32* s = (const uint32*)src;
+            uint32 a = s[x0 + y0 * srcWidth], b = s[x1 + y0 * srcWidth], c = s[x0 + y1 * srcWidth], d = s[x1 + y1 * srcWidth];
+            uint32 rb = ((a & 0x00FF00FF) + (b & 0x00FF00FF) + (c & 0x00FF00FF) + (d & 0x00FF00FF) + 0x00020002) >> 2;
+            uint32 ag = (((a >> 8) & 0x00FF00FF) + ((b >> 8) & 0x00FF00FF) + ((c >> 8) & 0x00FF00FF) + ((d >> 8) & 0x00FF00FF) + 0x00020002) >> 2;
+            ((uint32*)dst)[x + y * width] = (rb & 0x00FF00FF) | ((ag & 0x00FF00FF) << 8);
+        }
+    }
+}
+
+static inline bool easyWIN32_AssetCanBake(const ew32_texture* t) {
+    return (t->bitDepth == 8 || t->bitDepth == 32) && t->width > 0 && t->height > 0 && t->width <= ASSET_MAX_SIZE && t->height <= ASSET_MAX_SIZE;
+}
+
+// FNV-1a hash of the baking parameters and of the finest level of every texture
+static inline uint32 easyWIN32_Fnv1a(uint32 hash, const void* data, uint64 size) {
+    for (uint64 i = 0; i < size; ++i) hash = (hash ^ ((const uint8*)data)[i]) * 16777619u;
+    return hash;
+}
+static uint32 easyWIN32_AssetChecksum(const ew32_texture* textures, uint count, bool doMipmaps) {
+    uint32 hash = 2166136261u;
+    uint32 params[2] = { count, doMipmaps };
+    hash = easyWIN32_Fnv1a(hash, params, sizeof(params));
+    for (uint i = 0; i < count; ++i) {
+        const ew32_texture* t = textures + i;
+        uint32 dims[3] = { t->width, t->height, t->bitDepth };
+        hash = easyWIN32_Fnv1a(hash, dims, sizeof(dims));
+        hash = easyWIN32_Fnv1a(hash, t->buffer, easyWIN32_LevelBytes(t->width, t->height, t->bitDepth, 0));
+    }
+    return hash;
+}
+
+bool EW32_textureAssetIsCurrent(const char* path, const ew32_texture* textures, uint count, bool doMipmaps) {
+    for (uint i = 0; i < count; ++i) if (!easyWIN32_AssetCanBake(textures + i)) return false;
+
+    FILE* file = fopen(path, "rb");
+    if (!file) return false;
+    asset_header header;
+    bool read = fread(&header, sizeof(header), 1, file) == 1;
+    fclose(file);
+
+    return read && header.magic == ASSET_MAGIC && header.version == ASSET_VERSION && header.nbTextures == count
+        && header.checksum == easyWIN32_AssetChecksum(textures, count, doMipmaps);
+}
+
+bool EW32_textureAssetWrite(const char* path, const ew32_texture* textures, uint count, bool doMipmaps) {
+    asset_texture* entries = calloc(count ? count : 1, sizeof(asset_texture));
+    uint64 offset = sizeof(asset_header) + count * sizeof(asset_texture), maxBytes = 0;
+    for (uint i = 0; i < count; ++i) {
+        const ew32_texture* t = textures + i;
+        if (!easyWIN32_AssetCanBake(t)) {
+            fprintf(stderr, "[EasyWIN32] Texture %u can not be baked (%dx%d, %d bits)!\n", i, t->width, t->height, t->bitDepth);
+            free(entries);
+            return false;
+        }
+
+        offset = (offset + ASSET_ALIGNMENT - 1) & ~(uint64)(ASSET_ALIGNMENT - 1);
+        entries[i] = (asset_texture){ .width = t->width, .height = t->height, .bitDepth = t->bitDepth, .offset = offset };
+        entries[i].nbLevels = doMipmaps ? easyWIN32_CountLevels(t->width, t->height) : 1;
+        for (uint l = 0; l < entries[i].nbLevels; ++l) offset += easyWIN32_LevelBytes(t->width, t->height, t->bitDepth, l);
+
+        uint64 bytes = easyWIN32_LevelBytes(t->width, t->height, t->bitDepth, 0);
+        if (bytes > maxBytes) maxBytes = bytes;
+    }
+
+    FILE* file = fopen(path, "wb");
+    if (!file) {
+        fprintf(stderr, "[EasyWIN32] Failed to open '%s' for writing!\n", path);
+        free(entries);
+        return false;
+    }
+
+    // The checksum is written last, once every level is on disk: a truncated file is never taken for a current one
+    asset_header header = { .magic = ASSET_MAGIC, .version = ASSET_VERSION, .nbTextures = count };
+    bool ok = fwrite(&header, sizeof(header), 1, file) == 1;
+    if (ok && count) ok = fwrite(entries, sizeof(asset_texture), count, file) == count;
+
+    // Two scratch levels, swapped while going down the mip chain
+    uint8* levels[2] = { malloc(maxBytes ? maxBytes : 1), malloc(maxBytes ? maxBytes : 1) };
+    if (!levels[0] || !levels[1]) {
+        fprintf(stderr, "[EasyWIN32] Failed to allocate texture levels!\n");
+        ok = false;
+    }
+    for (uint i = 0; ok && i < count; ++i) {
+        const asset_texture* e = entries + i;
+        ok = easyWIN32_FileSeek(file, e->offset);
+
+        memcpy(levels[0], textures[i].buffer, easyWIN32_LevelBytes(e->width, e->height, e->bitDepth, 0));
+        for (uint l = 0; ok && l < e->nbLevels; ++l) {
+            uint64 bytes = easyWIN32_LevelBytes(e->width, e->height, e->bitDepth, l);
+            ok = fwrite(levels[l & 1], 1, bytes, file) == bytes;
+            if (l + 1 < e->nbLevels) easyWIN32_Downsample(levels[(l + 1) & 1], levels[l & 1], easyWIN32_LevelDim(e->width, l), easyWIN32_LevelDim(e->height, l), e->bitDepth);
+        }
+    }
+    free(levels[0]);
+    free(levels[1]);
+    free(entries);
+
+    header.checksum = easyWIN32_AssetChecksum(textures, count, doMipmaps);
+    ok = ok && fflush(file) == 0 && easyWIN32_FileSeek(file, 0) && fwrite(&header, sizeof(header), 1, file) == 1;
+    ok = !ferror(file) && ok;
+    if (fclose(file) != 0 || !ok) {
+        fprintf(stderr, "[EasyWIN32] Failed to write texture asset file '%s'!\n", path);
+        remove(path); // Never leave a partial file behind
+        return false;
+    }
+    return true;
+}
+
+///// CACHE
+
+typedef struct CacheLevel {
+    ew32_texture texture; // "buffer" is NULL when the level is not resident
+    uint64 offset, bytes; // Where the texels are in the file
+    uint64 lastUse; // Frame of the last request
+    int prev, next; // LRU list of resident levels (most recent first), -1 at the ends
+    bool requested; // Queued to be paged in at the next frame
+} cache_level;
+
+typedef struct CacheTexture {
+    uint firstLevel, nbLevels;
+} cache_texture;
+
+struct EasyWIN32_TextureCache {
+    const uint8* file;
+    uint64 fileSize;
+#ifdef _WIN32
+    HANDLE fileHandle, mapping;
+#endif
+
+    cache_texture* textures;
+    uint nbTextures;
+    cache_level* levels;
+    uint nbLevels;
+
+    int lruHead, lruTail;
+    uint* requests; // Levels missed during the current frame
+    uint nbRequests;
+
+    uint64 frame;
+    uint64 residentBytes, budgetBytes;
+    ew32_texture_cache_stats stats;
+};
+
+static bool easyWIN32_MapFile(ew32_texture_cache* cache, const char* path) {
+#ifdef _WIN32
+    cache->fileHandle = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (cache->fileHandle == INVALID_HANDLE_VALUE) return false;
+
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(cache->fileHandle, &size) || !size.QuadPart) return false;
+    cache->fileSize = size.QuadPart;
+    if (cache->fileSize > SIZE_MAX) return false; // Does not fit in the address space of a 32 bits build
+
+    cache->mapping = CreateFileMappingA(cache->fileHandle, NULL, PAGE_READONLY, 0, 0, NULL);
+    if (!cache->mapping) return false;
+    cache->file = MapViewOfFile(cache->mapping, FILE_MAP_READ, 0, 0, 0);
+    return cache->file != NULL;
+#else
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) return false;
+
+    struct stat st;
+    if (fstat(fd, &st) || !st.st_size) { close(fd); return false; }
+    cache->fileSize = st.st_size;
+    if (cache->fileSize > SIZE_MAX) { close(fd); return false; } // Does not fit in the address space of a 32 bits build
+
+    void* file = mmap(NULL, (size_t)cache->fileSize, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd); // The mapping keeps the file alive
+    if (file == MAP_FAILED) return false;
+    cache->file = file;
+    return true;
+#endif
+}
+
+static void easyWIN32_UnmapFile(ew32_texture_cache* cache) {
+#ifdef _WIN32
+    if (cache->file) UnmapViewOfFile(cache->file);
+    if (cache->mapping) CloseHandle(cache->mapping);
+    if (cache->fileHandle && cache->fileHandle != INVALID_HANDLE_VALUE) CloseHandle(cache->fileHandle);
+#else
+    if (cache->file) munmap((void*)cache->file, (size_t)cache->fileSize);
+#endif
+}
+
+// Check the asset file and build the level table
+static bool easyWIN32_CacheReadTable(ew32_texture_cache* cache) {
+    if (cache->fileSize < sizeof(asset_header)) return false;
+    asset_header header;
+    memcpy(&header, cache->file, sizeof(header));
+    if (header.magic != ASSET_MAGIC || header.version != ASSET_VERSION) return false;
+    if ((cache->fileSize - sizeof(asset_header)) / sizeof(asset_texture) < header.nbTextures) return false;
+
+    const asset_texture* entries = (const asset_texture*)(cache->file + sizeof(asset_header));
+    cache->nbTextures = header.nbTextures;
+    cache->textures = calloc(header.nbTextures ? header.nbTextures : 1, sizeof(cache_texture));
+    if (!cache->textures) return false;
+
+    cache->nbLevels = 0;
+    for (uint i = 0; i < header.nbTextures; ++i) {
+        const asset_texture* e = entries + i;
+        if ((e->bitDepth != 8 && e->bitDepth != 32) || !e->width || !e->height || e->width > ASSET_MAX_SIZE || e->height > ASSET_MAX_SIZE) return false;
+        if (!e->nbLevels || e->nbLevels > easyWIN32_CountLevels(e->width, e->height)) return false;
+
+        uint64 end = e->offset;
+        for (uint l = 0; l < e->nbLevels; ++l) end += easyWIN32_LevelBytes(e->width, e->height, e->bitDepth, l);
+        if (e->offset > cache->fileSize || end > cache->fileSize) return false;
+
+        cache->textures[i] = (cache_texture){ .firstLevel = cache->nbLevels, .nbLevels = e->nbLevels };
+        cache->nbLevels += e->nbLevels;
+    }
+
+    cache->levels = calloc(cache->nbLevels ? cache->nbLevels : 1, sizeof(cache_level));
+    cache->requests = malloc(sizeof(uint) * (cache->nbLevels ? cache->nbLevels : 1));
+    if (!cache->levels || !cache->requests) return false;
+
+    for (uint i = 0; i < header.nbTextures; ++i) {
+        const asset_texture* e = entries + i;
+        uint64 offset = e->offset;
+        for (uint l = 0; l < e->nbLevels; ++l) {
+            cache_level* level = cache->levels + cache->textures[i].firstLevel + l;
+            level->texture = (ew32_texture){ .width = easyWIN32_LevelDim(e->width, l), .height = easyWIN32_LevelDim(e->height, l), .bitDepth = e->bitDepth };
+            level->offset = offset;
+            level->bytes = easyWIN32_LevelBytes(e->width, e->height, e->bitDepth, l);
+            level->prev = level->next = -1;
+            offset += level->bytes;
+        }
+    }
+    return true;
+}
+
+ew32_texture_cache* EW32_textureCacheCreate(const char* path, uint64 budgetBytes) {
+    ew32_texture_cache* cache = calloc(1, sizeof(ew32_texture_cache));
+    if (!cache) {
+        fprintf(stderr, "[EasyWIN32] Failed to allocate texture cache!\n");
+        return NULL;
+    }
+    cache->lruHead = cache->lruTail = -1;
+    cache->budgetBytes = budgetBytes;
+
+    if (!easyWIN32_MapFile(cache, path)) {
+        fprintf(stderr, "[EasyWIN32] Failed to map texture asset file '%s'!\n", path);
+        EW32_textureCacheDestroy(cache);
+        return NULL;
+    }
+    if (!easyWIN32_CacheReadTable(cache)) {
+        fprintf(stderr, "[EasyWIN32] Invalid texture asset file '%s'!\n", path);
+        EW32_textureCacheDestroy(cache);
+        return NULL;
+    }
+    return cache;
+}
+
+void EW32_textureCacheDestroy(ew32_texture_cache* cache) {
+    if (!cache) return;
+    for (uint i = 0; i < cache->nbLevels; ++i) free(cache->levels[i].texture.buffer);
+    free(cache->levels);
+    free(cache->textures);
+    free(cache->requests);
+    easyWIN32_UnmapFile(cache);
+    free(cache);
+}
+
+static void easyWIN32_LruUnlink(ew32_texture_cache* cache, int index) {
+    cache_level* level = cache->levels + index;
+    if (level->prev >= 0) cache->levels[level->prev].next = level->next;
+    else cache->lruHead = level->next;
+    if (level->next >= 0) cache->levels[level->next].prev = level->prev;
+    else cache->lruTail = level->prev;
+    level->prev = level->next = -1;
+}
+static void easyWIN32_LruPushFront(ew32_texture_cache* cache, int index) {
+    cache_level* level = cache->levels + index;
+    level->prev = -1;
+    level->next = cache->lruHead;
+    if (cache->lruHead >= 0) cache->levels[cache->lruHead].prev = index;
+    else cache->lruTail = index;
+    cache->lruHead = index;
+}
+static inline const ew32_texture* easyWIN32_CacheUse(ew32_texture_cache* cache, int index) {
+    cache->levels[index].lastUse = cache->frame;
+    if (cache->lruHead != index) {
+        easyWIN32_LruUnlink(cache, index);
+        easyWIN32_LruPushFront(cache, index);
+    }
+    return &cache->levels[index].texture;
+}
+
+// Evict the least recently used levels until "bytes" fit, never touching levels used during the current frame
+static bool easyWIN32_CacheMakeRoom(ew32_texture_cache* cache, uint64 bytes) {
+    if (bytes > cache->budgetBytes) return false;
+    while (cache->residentBytes + bytes > cache->budgetBytes) {
+        int victim = cache->lruTail;
+        if (victim < 0 || cache->levels[victim].lastUse >= cache->frame) return false;
+
+        cache_level* level = cache->levels + victim;
+        easyWIN32_LruUnlink(cache, victim);
+        free(level->texture.buffer);
+        level->texture.buffer = NULL;
+        cache->residentBytes -= level->bytes;
+        cache->stats.evictions++;
+    }
+    return true;
+}
+
+static bool easyWIN32_CachePageIn(ew32_texture_cache* cache, int index) {
+    cache_level* level = cache->levels + index;
+    if (level->texture.buffer) return true;
+    if (!easyWIN32_CacheMakeRoom(cache, level->bytes)) return false;
+
+    level->texture.buffer = malloc(level->bytes);
+    if (!level->texture.buffer) {
+        fprintf(stderr, "[EasyWIN32] Failed to allocate texture level!\n");
+        return false;
+    }
+    memcpy(level->texture.buffer, cache->file + level->offset, level->bytes);
+    cache->residentBytes += level->bytes;
+    cache->stats.loads++;
+
+    level->lastUse = cache->frame;
+    easyWIN32_LruPushFront(cache, index);
+    return true;
+}
+
+void EW32_textureCacheBeginFrame(ew32_texture_cache* cache) {
+    EW32_PROFILE_BEGIN("EW32_TextureCacheStream");
+    cache->frame++;
+    for (uint i = 0; i < cache->nbRequests; ++i) {
+        cache->levels[cache->requests[i]].requested = false;
+        easyWIN32_CachePageIn(cache, cache->requests[i]); // Dropped if it does not fit, it will be requested again
+    }
+    cache->nbRequests = 0;
+    EW32_PROFILE_END();
+}
+
+const ew32_texture* EW32_textureCacheGet(ew32_texture_cache* cache, uint id, uint level) {
+    if (id >= cache->nbTextures) return NULL;
+    const cache_texture* texture = cache->textures + id;
+    if (level >= texture->nbLevels) level = texture->nbLevels - 1;
+
+    int index = texture->firstLevel + level;
+    if (cache->levels[index].texture.buffer) {
+        cache->stats.hits++;
+        return easyWIN32_CacheUse(cache, index);
+    }
+
+    cache->stats.misses++;
+    if (!cache->levels[index].requested) {
+        cache->levels[index].requested = true;
+        cache->requests[cache->nbRequests++] = index;
+    }
+
+    // Use a coarser level meanwhile
+    int last = texture->firstLevel + texture->nbLevels - 1;
+    for (int i = index + 1; i <= last; ++i) {
+        if (cache->levels[i].texture.buffer) return easyWIN32_CacheUse(cache, i);
+    }
+    // Nothing resident: the coarsest level is the smallest, so it is paged in right away
+    if (easyWIN32_CachePageIn(cache, last)) return easyWIN32_CacheUse(cache, last);
+    return NULL;
+}
+
+uint EW32_textureCacheCount(const ew32_texture_cache* cache) {
+    return cache->nbTextures;
+}
+
+bool EW32_textureCacheInfo(const ew32_texture_cache* cache, uint id, uint* width, uint* height, uint* nbLevels) {
+    if (id >= cache->nbTextures) return false;
+    const cache_level* level = cache->levels + cache->textures[id].firstLevel;
+    if (width) *width = level->texture.width;
+    if (height) *height = level->texture.height;
+    if (nbLevels) *nbLevels = cache->textures[id].nbLevels;
+    return true;
+}
+
+ew32_texture_cache_stats EW32_textureCacheGetStats(const ew32_texture_cache* cache) {
+    ew32_texture_cache_stats stats = cache->stats;
+    stats.residentBytes = cache->residentBytes;
+    stats.budgetBytes = cache->budgetBytes;
+    return stats;
+}
+
+void EW32_textureCacheResetStats(ew32_texture_cache* cache) {
+    cache->stats = (ew32_texture_cache_stats){0};
+}
@@ -0,0 +1,193 @@
+#include <stdlib.h>
+#include <string.h>
+
+#include "easyWIN32.h"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#   include <immintrin.h>
+#   define EW32_HAS_AVX2_KERNEL
+#endif
+
+// Every kernel below is generated from a macro template for one {pixel format, filter, blend mode},
+// so that the hot loops carry no format or mode branching. The right set is picked once through "PIPELINES".
+
+typedef uint8  pixel_INDEXED8;
+typedef uint32 pixel_RGB32;
+
+///// BLEND MODES
+
+#define BLEND_COPY(dst, src, key) (dst) = (src)
+#define BLEND_KEYED(dst, src, key) do { if ((src) != (key)) (dst) = (src); } while (0)
+
+///// FILL
+
+#define DEFINE_FILL(FORMAT) \
+static void easyWIN32_Fill_##FORMAT(void* dst, uint count, uint32 value) { \
+    pixel_##FORMAT* d = dst; \
+    pixel_##FORMAT v = (pixel_##FORMAT)value; \
+    for (uint i = 0; i < count; ++i) d[i] = v; \
+}
+
+DEFINE_FILL(INDEXED8)
+DEFINE_FILL(RGB32)
+
+///// BLIT
+
+#define DEFINE_BLIT(FORMAT, BLEND) \
+static void easyWIN32_Blit_##FORMAT##_##BLEND(void* dst, const void* src, uint count, uint32 key) { \
+    pixel_##FORMAT* d = dst; \
+    const pixel_##FORMAT* s = src; \
+    pixel_##FORMAT k = (pixel_##FORMAT)key; (void)k; \
+    for (uint i = 0; i < count; ++i) BLEND_##BLEND(d[i], s[i], k); \
+}
+
+DEFINE_BLIT(INDEXED8, COPY)
+DEFINE_BLIT(INDEXED8, KEYED)
+DEFINE_BLIT(RGB32, COPY)
+DEFINE_BLIT(RGB32, KEYED)
+
+///// SCALE
+
+// Source coordinates are stepped in 16.16 fixed point
+#define DEFINE_SCALE_NEAREST(FORMAT, BLEND) \
+static void easyWIN32_Scale_##FORMAT##_NEAREST_##BLEND(ew32_texture* dst, const ew32_texture* src, uint32 key) { \
+    uint32 stepX = ((uint64)src->width << 16) / dst->width; \
+    uint32 stepY = ((uint64)src->height << 16) / dst->height; \
+    pixel_##FORMAT k = (pixel_##FORMAT)key; (void)k; \
+    \
+    uint32 v = stepY >> 1; \
+    for (int y = 0; y < dst->height; ++y, v += stepY) { \
+        const pixel_##FORMAT* row = (const pixel_##FORMAT*)src->buffer + (v >> 16) * src->width; \
+        pixel_##FORMAT* out = (pixel_##FORMAT*)dst->buffer + y * dst->width; \
+        uint32 u = stepX >> 1; \
+        for (int x = 0; x < dst->width; ++x, u += stepX) BLEND_##BLEND(out[x], row[u >> 16], k); \
+    } \
+}
+
+DEFINE_SCALE_NEAREST(INDEXED8, COPY)
+DEFINE_SCALE_NEAREST(INDEXED8, KEYED)
+DEFINE_SCALE_NEAREST(RGB32, COPY)
+DEFINE_SCALE_NEAREST(RGB32, KEYED)
+
+// Interpolate two packed colors with an 8 bits weight, two channels at a time
+static inline uint32 easyWIN32_LerpRGB32(uint32 a, uint32 b, uint32 w) {
+    uint32 rb = ((a & 0x00FF00FF) * (256 - w) + (b & 0x00FF00FF) * w) >> 8;
+    uint32 ag = ((a >> 8) & 0x00FF00FF) * (256 - w) + ((b >> 8) & 0x00FF00FF) * w;
+    return (rb & 0x00FF00FF) | (ag & 0xFF00FF00);
+}
+
+// Only RGB32 can be filtered: the key of a keyed blend is tested on the top-left sample
+#define DEFINE_SCALE_BILINEAR(BLEND) \
+static void easyWIN32_Scale_RGB32_BILINEAR_##BLEND(ew32_texture* dst, const ew32_texture* src, uint32 key) { \
+    int32 stepX = ((int64)src->width << 16) / dst->width; \
+    int32 stepY = ((int64)src->height << 16) / dst->height; \
+    int32 maxU = (src->width - 1) << 16, maxV = (src->height - 1) << 16; \
+    \
+    int32 v = (stepY >> 1) - 0x8000; \
+    for (int y = 0; y < dst->height; ++y, v += stepY) { \
+        int32 cv = v < 0 ? 0 : v > maxV ? maxV : v; \
+        const pixel_RGB32* row0 = (const pixel_RGB32*)src->buffer + (cv >> 16) * src->width; \
+        const pixel_RGB32* row1 = (cv >> 16) + 1 < src->height ? row0 + src->width : row0; \
+        uint32 wy = (cv >> 8) & 0xFF; \
+        pixel_RGB32* out = (pixel_RGB32*)dst->buffer + y * dst->width; \
+        \
+        int32 u = (stepX >> 1) - 0x8000; \
+        for (int x = 0; x < dst->width; ++x, u += stepX) { \
+            int32 cu = u < 0 ? 0 : u > maxU ? maxU : u; \
+            int32 x0 = cu >> 16, x1 = x0 + (cu < maxU); \
+            if (BLEND_IS_##BLEND && row0[x0] == key) continue; \
+            uint32 wx = (cu >> 8) & 0xFF; \
+            pixel_RGB32 top = easyWIN32_LerpRGB32(row0[x0], row0[x1], wx); \
+            pixel_RGB32 bottom = easyWIN32_LerpRGB32(row1[x0], row1[x1], wx); \
+            out[x] = easyWIN32_LerpRGB32(top, bottom, wy); \
+        } \
+    } \
+}
+#define BLEND_IS_COPY 0
+#define BLEND_IS_KEYED 1
+
+DEFINE_SCALE_BILINEAR(COPY)
+DEFINE_SCALE_BILINEAR(KEYED)
+
+///// EXPAND
+
+#ifdef EW32_HAS_AVX2_KERNEL
+__attribute__((target("avx2")))
+static void easyWIN32_ExpandIndexedAVX2(uint32* dst, const uint8* src, uint count, const uint32* palette) {
+    uint i = 0;
+    for (; i + 16 <= count; i += 16) {
+        __m128i indices = _mm_loadu_si128((const __m128i*)(src + i));
+        __m256i lo = _mm256_cvtepu8_epi32(indices);
+        __m256i hi = _mm256_cvtepu8_epi32(_mm_srli_si128(indices, 8));
+        _mm256_storeu_si256((__m256i*)(dst + i),     _mm256_i32gather_epi32((const int*)palette, lo, 4));
+        _mm256_storeu_si256((__m256i*)(dst + i + 8), _mm256_i32gather_epi32((const int*)palette, hi, 4));
+    }
+    for (; i < count; ++i) dst[i] = palette[src[i]];
+}
+#endif
+static void easyWIN32_ExpandIndexedScalar(uint32* dst, const uint8* src, uint count, const uint32* palette) {
+    uint i = 0;
+    for (; i + 4 <= count; i += 4) {
+        uint32 indices; memcpy(&indices, src + i, 4); // One load for 4 pixels
+        dst[i + 0] = palette[indices & 0xFF];
+        dst[i + 1] = palette[(indices >> 8) & 0xFF];
+        dst[i + 2] = palette[(indices >> 16) & 0xFF];
+        dst[i + 3] = palette[indices >> 24];
+    }
+    for (; i < count; ++i) dst[i] = palette[src[i]];
+}
+void EW32_textureExpandIndexed(uint32* dst, const uint8* src, uint count, const uint32* palette) {
+#ifdef EW32_HAS_AVX2_KERNEL
+    // Reads flags filled once at startup, so it is cheap and safe to call from any thread
+    if (__builtin_cpu_supports("avx2")) { easyWIN32_ExpandIndexedAVX2(dst, src, count, palette); return; }
+#endif
+    easyWIN32_ExpandIndexedScalar(dst, src, count, palette);
+}
+
+
+///// PIPELINES
+
+// Palette indices cannot be interpolated, so INDEXED8 uses nearest sampling for both filters
+#define PIPELINE(FORMAT, FILTER, SCALE_FILTER, BLEND, EXPAND) { \
+    .format = EW32_FORMAT_##FORMAT, .filter = EW32_FILTER_##FILTER, .blend = EW32_BLEND_##BLEND, \
+    .fill = easyWIN32_Fill_##FORMAT, \
+    .blit = easyWIN32_Blit_##FORMAT##_##BLEND, \
+    .scale = easyWIN32_Scale_##FORMAT##_##SCALE_FILTER##_##BLEND, \
+    .expand = EXPAND \
+}
+
+static const ew32_pixel_pipeline PIPELINES[EW32_FORMAT_COUNT][EW32_FILTER_COUNT][EW32_BLEND_COUNT] = {
+    [EW32_FORMAT_INDEXED8] = {
+        [EW32_FILTER_NEAREST] = {
+            [EW32_BLEND_COPY]  = PIPELINE(INDEXED8, NEAREST, NEAREST, COPY,  EW32_textureExpandIndexed),
+            [EW32_BLEND_KEYED] = PIPELINE(INDEXED8, NEAREST, NEAREST, KEYED, EW32_textureExpandIndexed),
+        },
+        [EW32_FILTER_BILINEAR] = {
+            [EW32_BLEND_COPY]  = PIPELINE(INDEXED8, BILINEAR, NEAREST, COPY,  EW32_textureExpandIndexed),
+            [EW32_BLEND_KEYED] = PIPELINE(INDEXED8, BILINEAR, NEAREST, KEYED, EW32_textureExpandIndexed),
+        },
+    },
+    [EW32_FORMAT_RGB32] = {
+        [EW32_FILTER_NEAREST] = {
+            [EW32_BLEND_COPY]  = PIPELINE(RGB32, NEAREST, NEAREST, COPY,  NULL),
+            [EW32_BLEND_KEYED] = PIPELINE(RGB32, NEAREST, NEAREST, KEYED, NULL),
+        },
+        [EW32_FILTER_BILINEAR] = {
+            [EW32_BLEND_COPY]  = PIPELINE(RGB32, BILINEAR, BILINEAR, COPY,  NULL),
+            [EW32_BLEND_KEYED] = PIPELINE(RGB32, BILINEAR, BILINEAR, KEYED, NULL),
+        },
+    },
+};
+
+ew32_pixel_format EW32_pixelFormatFromBitDepth(int bitDepth) {
+    switch (bitDepth) {
+        case 8:  return EW32_FORMAT_INDEXED8;
+        case 32: return EW32_FORMAT_RGB32;
+        default: return EW32_FORMAT_COUNT;
+    }
+}
+
+const ew32_pixel_pipeline* EW32_pixelPipelineGet(ew32_pixel_format format, ew32_filter filter, ew32_blend blend) {
+    if (format >= EW32_FORMAT_COUNT || filter >= EW32_FILTER_COUNT || blend >= EW32_BLEND_COUNT) return NULL;
+    return &PIPELINES[format][filter][blend];
+}
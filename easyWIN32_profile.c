@@ -0,0 +1,222 @@
+#include <stdlib.h>
+#include <string.h>
+#include <stdatomic.h>
+
+#ifdef _WIN32
+#   include <windows.h>
+#else
+#   include <time.h>
+#endif
+
+#include "easyWIN32.h"
+
+#if (EW32_PROFILE_RING_SIZE & (EW32_PROFILE_RING_SIZE - 1)) != 0
+#   error "EW32_PROFILE_RING_SIZE must be a power of 2"
+#endif
+
+#define PROFILE_MAX_DEPTH 64 // Maximum zone nesting taken into account by the frame summary
+
+typedef struct EasyWIN32_ProfileEvent {
+    uint64 time;
+    const char* name; // NULL for the end of a zone
+} ew32_profile_event;
+
+typedef struct EasyWIN32_ProfileOpenZone {
+    const char* name;
+    uint64 time;
+} ew32_profile_open_zone;
+
+// One ring per thread: only the owning thread writes to it, so pushing an event is a plain store followed by a release of "head"
+typedef struct EasyWIN32_ProfileBuffer {
+    ew32_profile_event events[EW32_PROFILE_RING_SIZE];
+    _Atomic uint64 head; // Total number of events ever pushed
+    uint32 threadId; // Of the first thread that used the ring
+    _Atomic bool released; // Its thread called "EW32_profileThreadRelease": the next new thread reuses the ring
+
+    uint64 frameStart; // Index of the first event of the current frame
+    ew32_profile_open_zone openZones[PROFILE_MAX_DEPTH]; // Zones still open at "frameStart"
+    uint openDepth, openOverflow; // Number of zones in "openZones", and of open zones too deep to fit
+    ew32_profile_zone_stat summary[EW32_PROFILE_MAX_ZONES];
+    uint summaryCount;
+
+    struct EasyWIN32_ProfileBuffer* next;
+} ew32_profile_buffer;
+
+static _Atomic(ew32_profile_buffer*) PROFILE_BUFFERS = NULL; // Every buffer ever created, so that they can be exported
+static _Atomic uint32 PROFILE_THREAD_COUNT = 0;
+static _Thread_local ew32_profile_buffer* PROFILE_LOCAL = NULL;
+
+uint64 EW32_profileNow() {
+#ifdef _WIN32
+    static LARGE_INTEGER frequency = {0};
+    if (!frequency.QuadPart) QueryPerformanceFrequency(&frequency);
+    LARGE_INTEGER counter;
+    QueryPerformanceCounter(&counter);
+    return (uint64)((counter.QuadPart / frequency.QuadPart) * 1000000000ull + (counter.QuadPart % frequency.QuadPart) * 1000000000ull / frequency.QuadPart);
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64)ts.tv_sec * 1000000000ull + (uint64)ts.tv_nsec;
+#endif
+}
+
+static ew32_profile_buffer* easyWIN32_ProfileGetLocalBuffer() {
+    if (PROFILE_LOCAL) return PROFILE_LOCAL;
+
+    // Reuse the ring of a released thread, its events stay exportable until they are overwritten
+    for (ew32_profile_buffer* buffer = atomic_load(&PROFILE_BUFFERS); buffer; buffer = buffer->next) {
+        bool released = true;
+        if (!atomic_load_explicit(&buffer->released, memory_order_relaxed) || !atomic_compare_exchange_strong(&buffer->released, &released, false)) continue;
+
+        buffer->frameStart = atomic_load_explicit(&buffer->head, memory_order_relaxed);
+        buffer->openDepth = buffer->openOverflow = 0;
+        buffer->summaryCount = 0;
+        return PROFILE_LOCAL = buffer;
+    }
+
+    ew32_profile_buffer* buffer = calloc(1, sizeof(ew32_profile_buffer));
+    if (!buffer) {
+        fprintf(stderr, "[EasyWIN32] Failed to allocate profiling buffer!\n");
+        exit(1);
+    }
+    buffer->threadId = atomic_fetch_add(&PROFILE_THREAD_COUNT, 1) + 1;
+
+    buffer->next = atomic_load(&PROFILE_BUFFERS);
+    while (!atomic_compare_exchange_weak(&PROFILE_BUFFERS, &buffer->next, buffer));
+
+    return PROFILE_LOCAL = buffer;
+}
+
+static inline void easyWIN32_ProfilePush(const char* name) {
+    ew32_profile_buffer* buffer = easyWIN32_ProfileGetLocalBuffer();
+    uint64 head = atomic_load_explicit(&buffer->head, memory_order_relaxed);
+    buffer->events[head & (EW32_PROFILE_RING_SIZE - 1)] = (ew32_profile_event){ .time = EW32_profileNow(), .name = name };
+    atomic_store_explicit(&buffer->head, head + 1, memory_order_release);
+}
+
+void EW32_profileBegin(const char* name) { easyWIN32_ProfilePush(name); }
+void EW32_profileEnd() { easyWIN32_ProfilePush(NULL); }
+
+void EW32_profileThreadRelease() {
+    if (!PROFILE_LOCAL) return;
+    atomic_store_explicit(&PROFILE_LOCAL->released, true, memory_order_release);
+    PROFILE_LOCAL = NULL;
+}
+
+static ew32_profile_zone_stat* easyWIN32_ProfileFindZone(ew32_profile_buffer* buffer, const char* name) {
+    for (uint i = 0; i < buffer->summaryCount; ++i) {
+        if (buffer->summary[i].name == name || !strcmp(buffer->summary[i].name, name)) return buffer->summary + i;
+    }
+    if (buffer->summaryCount >= EW32_PROFILE_MAX_ZONES) return NULL;
+
+    ew32_profile_zone_stat* zone = buffer->summary + buffer->summaryCount++;
+    *zone = (ew32_profile_zone_stat){ .name = name };
+    return zone;
+}
+
+void EW32_profileFrameMark() {
+    ew32_profile_buffer* buffer = easyWIN32_ProfileGetLocalBuffer();
+    uint64 head = atomic_load_explicit(&buffer->head, memory_order_relaxed);
+    uint64 start = buffer->frameStart;
+    if (head - start > EW32_PROFILE_RING_SIZE) start = head - EW32_PROFILE_RING_SIZE; // Frame larger than the ring, only the tail is summarized
+
+    // Zones opened during previous frames are closed against the stack they left
+    ew32_profile_open_zone* stack = buffer->openZones;
+    uint depth = buffer->openDepth, overflow = buffer->openOverflow;
+
+    buffer->summaryCount = 0;
+    for (uint64 i = start; i < head; ++i) {
+        ew32_profile_event* event = buffer->events + (i & (EW32_PROFILE_RING_SIZE - 1));
+
+        if (event->name) {
+            if (depth < PROFILE_MAX_DEPTH) { stack[depth].name = event->name; stack[depth].time = event->time; depth++; }
+            else overflow++;
+            continue;
+        }
+
+        if (overflow) { overflow--; continue; }
+        if (!depth) continue; // Zone opened before the start of the ring
+
+        depth--;
+        ew32_profile_zone_stat* zone = easyWIN32_ProfileFindZone(buffer, stack[depth].name);
+        if (!zone) continue;
+
+        double time = (event->time - stack[depth].time) * 1e-9;
+        zone->totalTime += time;
+        if (time > zone->maxTime) zone->maxTime = time;
+        zone->count++;
+    }
+
+    // Zones still open carry over to the next frame, where they are counted when they close
+    buffer->frameStart = head;
+    buffer->openDepth = depth;
+    buffer->openOverflow = overflow;
+}
+
+uint EW32_profileFrameSummary(ew32_profile_zone_stat* stats, uint maxCount) {
+    ew32_profile_buffer* buffer = easyWIN32_ProfileGetLocalBuffer();
+    uint count = buffer->summaryCount < maxCount ? buffer->summaryCount : maxCount;
+    memcpy(stats, buffer->summary, count * sizeof(ew32_profile_zone_stat));
+    return count;
+}
+
+void EW32_profilePrintFrameSummary(FILE* file) {
+    ew32_profile_buffer* buffer = easyWIN32_ProfileGetLocalBuffer();
+    fprintf(file, "[EasyWIN32] Frame profile (thread %u):\n", buffer->threadId);
+    for (uint i = 0; i < buffer->summaryCount; ++i) {
+        ew32_profile_zone_stat* zone = buffer->summary + i;
+        fprintf(file, "    %-24s %9.3f ms total  %9.3f ms max  x%u\n", zone->name, zone->totalTime * 1e3, zone->maxTime * 1e3, zone->count);
+    }
+}
+
+static void easyWIN32_ProfileWriteName(FILE* file, const char* name) {
+    for (; *name; ++name) {
+        if (*name == '"' || *name == '\\') fputc('\\', file);
+        if ((uint8)*name >= 0x20) fputc(*name, file);
+    }
+}
+
+bool EW32_profileExportChromeTrace(const char* path) {
+    FILE* file = fopen(path, "w");
+    if (!file) {
+        fprintf(stderr, "[EasyWIN32] Failed to open '%s' for writing!\n", path);
+        return false;
+    }
+
+    ew32_profile_event* events = malloc(sizeof(ew32_profile_event) * EW32_PROFILE_RING_SIZE);
+    if (!events) {
+        fprintf(stderr, "[EasyWIN32] Failed to allocate profiling export buffer!\n");
+        fclose(file);
+        return false;
+    }
+
+    fprintf(file, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[");
+    bool first = true;
+    for (ew32_profile_buffer* buffer = atomic_load(&PROFILE_BUFFERS); buffer; buffer = buffer->next) {
+        // Copy the ring first: its thread may keep pushing events meanwhile
+        uint64 head = atomic_load_explicit(&buffer->head, memory_order_acquire);
+        uint64 start = head > EW32_PROFILE_RING_SIZE ? head - EW32_PROFILE_RING_SIZE : 0;
+        for (uint64 i = start; i < head; ++i) events[i - start] = buffer->events[i & (EW32_PROFILE_RING_SIZE - 1)];
+
+        // The event being pushed now ("after") overwrites event "after - EW32_PROFILE_RING_SIZE": drop every copied event that may have been overwritten
+        atomic_thread_fence(memory_order_acquire);
+        uint64 after = atomic_load_explicit(&buffer->head, memory_order_relaxed);
+        uint64 firstValid = after >= EW32_PROFILE_RING_SIZE ? after - EW32_PROFILE_RING_SIZE + 1 : 0;
+
+        for (uint64 i = firstValid > start ? firstValid : start; i < head; ++i) {
+            ew32_profile_event event = events[i - start];
+            fprintf(file, "%s\n{\"ph\":\"%c\",\"pid\":1,\"tid\":%u,\"ts\":%.3f", first ? "" : ",", event.name ? 'B' : 'E', buffer->threadId, event.time * 1e-3);
+            if (event.name) {
+                fprintf(file, ",\"name\":\"");
+                easyWIN32_ProfileWriteName(file, event.name);
+                fputc('"', file);
+            }
+            fputc('}', file);
+            first = false;
+        }
+    }
+    fprintf(file, "\n]}\n");
+    free(events);
+
+    return fclose(file) == 0;
+}
@@ -0,0 +1,370 @@
+// EasyWIN32 tests
+// Runs headless (no window is needed on non-Win32 platforms), prints one line per failed check and returns the number of failures.
+
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include <time.h>
+
+#include "../easyWIN32.h"
+
+static uint NB_CHECKS = 0, NB_FAILURES = 0;
+
+#define CHECK(condition) do { \
+    NB_CHECKS++; \
+    if (!(condition)) { NB_FAILURES++; fprintf(stderr, "%s:%d: check failed: %s\n", __FILE__, __LINE__, #condition); } \
+} while (0)
+
+// Place a temporary file in the system temporary directory
+static void testTempPath(char* path, uint size, const char* name) {
+    const char* dir = getenv("TMPDIR");
+    if (!dir || !*dir) dir = getenv("TEMP");
+    if (!dir || !*dir) dir = getenv("TMP");
+#ifdef _WIN32
+    if (!dir || !*dir) dir = ".";
+#else
+    if (!dir || !*dir) dir = "/tmp";
+#endif
+    snprintf(path, size, "%s/%s", dir, name);
+}
+
+static ew32_context* testContext() {
+    ew32_init_params params = EW32_GetDefaultInitParams();
+    params.width = params.height = 16;
+    params.doHeadless = true;
+    return EW32_contextCreate("EasyWIN32 test", params);
+}
+
+
+
+///// INPUT
+
+static bool testKeyIs(ew32_context* ctx, ew32_key key, ew32_input_state state) { return (EW32_inputGetKeyStateCtx(ctx, key) & state) != 0; }
+
+static void testInputEdges() {
+    ew32_context* ctx = testContext();
+
+    // Press then hold
+    EW32_inputSimulateKeyCtx(ctx, EW32_KEY_A, true);
+    EW32_StartFrameCtx(ctx);
+    CHECK( testKeyIs(ctx, EW32_KEY_A, EW32_INPUT_DOWN));
+    CHECK( testKeyIs(ctx, EW32_KEY_A, EW32_INPUT_PRESSED));
+    CHECK(!testKeyIs(ctx, EW32_KEY_A, EW32_INPUT_RELEASED));
+    CHECK(!testKeyIs(ctx, EW32_KEY_A, EW32_INPUT_UP));
+    EW32_EndFrameCtx(ctx);
+    EW32_inputSimulateKeyCtx(ctx, EW32_KEY_A, true); // Repeated key down
+    EW32_StartFrameCtx(ctx);
+    CHECK( testKeyIs(ctx, EW32_KEY_A, EW32_INPUT_DOWN));
+    CHECK(!testKeyIs(ctx, EW32_KEY_A, EW32_INPUT_PRESSED));
+    EW32_EndFrameCtx(ctx);
+
+    // Released, then pressed again within the same frame
+    EW32_inputSimulateKeyCtx(ctx, EW32_KEY_A, false);
+    EW32_inputSimulateKeyCtx(ctx, EW32_KEY_A, true);
+    EW32_StartFrameCtx(ctx);
+    CHECK( testKeyIs(ctx, EW32_KEY_A, EW32_INPUT_DOWN));
+    CHECK( testKeyIs(ctx, EW32_KEY_A, EW32_INPUT_PRESSED));
+    CHECK( testKeyIs(ctx, EW32_KEY_A, EW32_INPUT_RELEASED));
+    EW32_EndFrameCtx(ctx);
+
+    // Release
+    EW32_inputSimulateKeyCtx(ctx, EW32_KEY_A, false);
+    EW32_StartFrameCtx(ctx);
+    CHECK(!testKeyIs(ctx, EW32_KEY_A, EW32_INPUT_DOWN));
+    CHECK( testKeyIs(ctx, EW32_KEY_A, EW32_INPUT_UP));
+    CHECK(!testKeyIs(ctx, EW32_KEY_A, EW32_INPUT_PRESSED));
+    CHECK( testKeyIs(ctx, EW32_KEY_A, EW32_INPUT_RELEASED));
+    EW32_EndFrameCtx(ctx);
+
+    // Tap: pressed and released within the same frame
+    EW32_inputSimulateKeyCtx(ctx, EW32_KEY_SPACE, true);
+    EW32_inputSimulateKeyCtx(ctx, EW32_KEY_SPACE, false);
+    EW32_StartFrameCtx(ctx);
+    CHECK(!testKeyIs(ctx, EW32_KEY_SPACE, EW32_INPUT_DOWN));
+    CHECK( testKeyIs(ctx, EW32_KEY_SPACE, EW32_INPUT_UP));
+    CHECK( testKeyIs(ctx, EW32_KEY_SPACE, EW32_INPUT_PRESSED));
+    CHECK( testKeyIs(ctx, EW32_KEY_SPACE, EW32_INPUT_RELEASED));
+    EW32_EndFrameCtx(ctx);
+
+    // Edges only last one frame
+    EW32_StartFrameCtx(ctx);
+    CHECK(!testKeyIs(ctx, EW32_KEY_SPACE, EW32_INPUT_PRESSED | EW32_INPUT_RELEASED));
+    CHECK(!testKeyIs(ctx, EW32_KEY_A, EW32_INPUT_PRESSED | EW32_INPUT_RELEASED));
+    EW32_EndFrameCtx(ctx);
+
+    EW32_contextDestroy(ctx);
+}
+
+static void testInputKeyIndices() {
+    for (int key = 0; key < EW32_KEY_COUNT; ++key) CHECK(EW32_inputKeyIndex(key) < EW32_INPUT_NB_KEYS);
+    CHECK(EW32_inputKeyIndex(EW32_KEY_COUNT) == 0);
+    CHECK(EW32_inputKeyIndex(EW32_KEY_A) != 0);
+}
+
+
+
+///// TIME
+
+static void testSleep(double seconds) {
+    struct timespec delay = { .tv_sec = (time_t)seconds, .tv_nsec = (long)((seconds - (time_t)seconds) * 1e9) };
+    nanosleep(&delay, NULL);
+}
+
+static void testTimeFixedStep() {
+    ew32_init_params params = EW32_GetDefaultInitParams();
+    params.width = params.height = 16;
+    params.doHeadless = true;
+    params.tickRate = 100.0;
+    params.maxTicksPerFrame = 0; // Default
+    ew32_context* ctx = EW32_contextCreate("EasyWIN32 test time", params);
+    double tickDt = EW32_timeTickDeltaCtx(ctx), elapsed = 0.0;
+    CHECK(tickDt == 0.01);
+
+    // Every measured second is simulated, dropped or still accumulated
+    uint maxTicks = 0;
+    for (uint frame = 0; frame < 12; ++frame) {
+        testSleep(frame == 8 ? 0.15 : 0.015); // Frame 8 is a hitch: its steps are due during frame 9
+        EW32_StartFrameCtx(ctx);
+        uint ticks = 0;
+        while (EW32_timeTickCtx(ctx)) ticks++;
+        if (ticks > maxTicks) maxTicks = ticks;
+
+        double alpha = EW32_timeAlphaCtx(ctx);
+        CHECK(alpha >= 0.0 && alpha < 1.0);
+        double accounted = EW32_timeTickCountCtx(ctx) * tickDt + EW32_timeDroppedCtx(ctx) + alpha * tickDt;
+        CHECK(accounted > elapsed - 1e-6 && accounted < elapsed + 1e-6);
+        if (frame == 9) CHECK(ticks == 8);
+
+        EW32_EndFrameCtx(ctx);
+        elapsed += EW32_timeDeltaCtx(ctx);
+    }
+    CHECK(maxTicks == 8);
+    CHECK(EW32_timeTickCountCtx(ctx) > 8);
+    CHECK(EW32_timeDroppedCtx(ctx) > 0.05);
+    EW32_contextDestroy(ctx);
+}
+
+
+
+///// IDLE MODE
+
+static void* testRequestRedrawLater(void* data) {
+    testSleep(0.05);
+    EW32_RequestRedrawCtx(data); // The only context function safe to call from another thread
+    return NULL;
+}
+
+static void testIdleWake() {
+    ew32_init_params params = EW32_GetDefaultInitParams();
+    params.width = params.height = 16;
+    params.doHeadless = true;
+    params.doIdleWait = true;
+    params.idleMaxWait = 5.0;
+    ew32_context* ctx = EW32_contextCreate("EasyWIN32 test idle", params);
+    EW32_StartFrameCtx(ctx); // The first frame never waits
+    EW32_EndFrameCtx(ctx);
+
+    // Pending simulated input skips the wait
+    EW32_inputSimulateKeyCtx(ctx, EW32_KEY_A, true);
+    uint64 start = EW32_profileNow();
+    EW32_StartFrameCtx(ctx);
+    double waited = (EW32_profileNow() - start) * 1e-9;
+    CHECK(waited < 1.0);
+    CHECK(EW32_ShouldRedrawCtx(ctx));
+    CHECK(testKeyIs(ctx, EW32_KEY_A, EW32_INPUT_PRESSED));
+    EW32_EndFrameCtx(ctx);
+
+    // A redraw request from another thread ends the wait
+    pthread_t thread;
+    pthread_create(&thread, NULL, testRequestRedrawLater, ctx);
+    start = EW32_profileNow();
+    EW32_StartFrameCtx(ctx);
+    waited = (EW32_profileNow() - start) * 1e-9;
+    pthread_join(thread, NULL);
+    CHECK(waited < 2.0);
+    CHECK(EW32_ShouldRedrawCtx(ctx));
+    EW32_EndFrameCtx(ctx);
+    EW32_contextDestroy(ctx);
+}
+
+
+
+///// TEXTURE CACHE
+
+static void testCacheAssetIsCurrent() {
+    char path[1024];
+    testTempPath(path, sizeof(path), "ew32_tests_current.ew32t");
+    uint8 texels[16 * 16];
+    for (uint i = 0; i < sizeof(texels); ++i) texels[i] = i;
+    ew32_texture texture = { .width = 16, .height = 16, .bitDepth = 8, .buffer = texels };
+
+    remove(path);
+    CHECK(!EW32_textureAssetIsCurrent(path, &texture, 1, true));
+    CHECK( EW32_textureAssetWrite(path, &texture, 1, true));
+    CHECK( EW32_textureAssetIsCurrent(path, &texture, 1, true));
+    CHECK(!EW32_textureAssetIsCurrent(path, &texture, 1, false));
+    texels[42] ^= 1;
+    CHECK(!EW32_textureAssetIsCurrent(path, &texture, 1, true));
+    remove(path);
+}
+
+
+static void testCacheEviction() {
+    char path[1024];
+    testTempPath(path, sizeof(path), "ew32_tests_cache.ew32t");
+    enum { NB = 3, SIZE = 16 }; // Levels of 256, 64, 16, 4 and 1 bytes
+    uint8 texels[NB][SIZE * SIZE];
+    ew32_texture textures[NB];
+    for (uint t = 0; t < NB; ++t) {
+        for (uint i = 0; i < SIZE * SIZE; ++i) texels[t][i] = i + 7 * t;
+        textures[t] = (ew32_texture){ .width = SIZE, .height = SIZE, .bitDepth = 8, .buffer = texels[t] };
+    }
+    CHECK(EW32_textureAssetWrite(path, textures, NB, true));
+
+    // Room for two full levels, not three
+    ew32_texture_cache* cache = EW32_textureCacheCreate(path, 600);
+    CHECK(cache != NULL);
+    if (!cache) { remove(path); return; }
+    uint width, height, nbLevels;
+    CHECK(EW32_textureCacheCount(cache) == NB);
+    CHECK(EW32_textureCacheInfo(cache, 1, &width, &height, &nbLevels) && width == SIZE && height == SIZE && nbLevels == 5);
+    CHECK(EW32_textureCacheGetStats(cache).residentBytes == 0); // Nothing is paged in before it is requested
+
+    // A miss returns the coarsest level right away, and pages the wanted one in at the next frame
+    for (uint t = 0; t < NB; ++t) {
+        EW32_textureCacheBeginFrame(cache);
+        const ew32_texture* coarse = EW32_textureCacheGet(cache, t, 0);
+        CHECK(coarse && coarse->width == 1 && coarse->height == 1);
+
+        EW32_textureCacheBeginFrame(cache);
+        const ew32_texture* full = EW32_textureCacheGet(cache, t, 0);
+        CHECK(full && full->width == SIZE && !memcmp(full->buffer, texels[t], sizeof(texels[t])));
+        CHECK(EW32_textureCacheGetStats(cache).residentBytes <= 600);
+    }
+
+    // Texture 0 is the least recently used: its full level made room for texture 2
+    ew32_texture_cache_stats stats = EW32_textureCacheGetStats(cache);
+    CHECK(stats.hits == NB && stats.misses == NB && stats.evictions > 0);
+    CHECK(stats.loads == 2 * NB);
+    EW32_textureCacheBeginFrame(cache);
+    const ew32_texture* evicted = EW32_textureCacheGet(cache, 0, 0);
+    CHECK(evicted && evicted->width < SIZE);
+    const ew32_texture* kept = EW32_textureCacheGet(cache, 2, 0);
+    CHECK(kept && kept->width == SIZE);
+
+    EW32_textureCacheDestroy(cache);
+
+    // Levels used during the current frame are never evicted: room for one full level and one coarse level
+    cache = EW32_textureCacheCreate(path, 256 + 1);
+    CHECK(cache != NULL);
+    if (!cache) { remove(path); return; }
+    EW32_textureCacheBeginFrame(cache);
+    EW32_textureCacheGet(cache, 0, 0);
+    EW32_textureCacheBeginFrame(cache);
+    const ew32_texture* pinned = EW32_textureCacheGet(cache, 0, 0);
+    CHECK(pinned && pinned->width == SIZE);
+    const ew32_texture* coarse = EW32_textureCacheGet(cache, 1, 0); // Evicts the coarse level of texture 0, unused this frame
+    CHECK(coarse && coarse->width == 1);
+    CHECK(EW32_textureCacheGet(cache, 2, 0) == NULL); // Everything resident is in use
+    CHECK(!memcmp(pinned->buffer, texels[0], sizeof(texels[0])));
+    CHECK(EW32_textureCacheGetStats(cache).residentBytes == 256 + 1);
+
+    EW32_textureCacheDestroy(cache);
+    remove(path);
+}
+
+
+
+///// PROFILING
+
+static const ew32_profile_zone_stat* testFindZone(const ew32_profile_zone_stat* stats, uint count, const char* name) {
+    for (uint i = 0; i < count; ++i) if (!strcmp(stats[i].name, name)) return stats + i;
+    return NULL;
+}
+
+static void testProfileFrameSummary() {
+    ew32_profile_zone_stat stats[EW32_PROFILE_MAX_ZONES];
+    EW32_profileFrameMark(); // Start from a clean frame
+
+    // A zone left open carries over to the next frame
+    EW32_profileBegin("test_open");
+    EW32_profileBegin("test_closed");
+    EW32_profileBegin("test_nested");
+    EW32_profileEnd();
+    EW32_profileEnd();
+    EW32_profileBegin("test_closed");
+    EW32_profileEnd();
+    EW32_profileFrameMark();
+    uint count = EW32_profileFrameSummary(stats, EW32_PROFILE_MAX_ZONES);
+    const ew32_profile_zone_stat* closed = testFindZone(stats, count, "test_closed");
+    CHECK(count == 2);
+    CHECK(closed && closed->count == 2 && closed->maxTime <= closed->totalTime);
+    CHECK(testFindZone(stats, count, "test_nested"));
+    CHECK(!testFindZone(stats, count, "test_open"));
+
+    // It is counted once, in the frame it closes in, and closed zones are not counted again
+    EW32_profileEnd();
+    EW32_profileFrameMark();
+    count = EW32_profileFrameSummary(stats, EW32_PROFILE_MAX_ZONES);
+    const ew32_profile_zone_stat* open = testFindZone(stats, count, "test_open");
+    CHECK(count == 1);
+    CHECK(open && open->count == 1);
+
+    EW32_profileFrameMark();
+    CHECK(EW32_profileFrameSummary(stats, EW32_PROFILE_MAX_ZONES) == 0);
+}
+
+
+static void* testProfileThread(void* data) {
+    (void)data;
+    EW32_profileBegin("test_thread");
+    EW32_profileEnd();
+    EW32_profileThreadRelease();
+    return NULL;
+}
+
+static void testProfileThreadRelease() {
+    char path[1024];
+    testTempPath(path, sizeof(path), "ew32_tests_trace.json");
+
+    // The second thread reuses the ring released by the first one, so its events keep the same thread id
+    for (uint i = 0; i < 2; ++i) {
+        pthread_t thread;
+        pthread_create(&thread, NULL, testProfileThread, NULL);
+        pthread_join(thread, NULL);
+    }
+    CHECK(EW32_profileExportChromeTrace(path));
+
+    FILE* file = fopen(path, "r");
+    CHECK(file != NULL);
+    if (!file) return;
+    char line[256];
+    uint nbThreadZones = 0, threadId = 0;
+    bool sameThread = true;
+    while (fgets(line, sizeof(line), file)) {
+        uint tid;
+        if (!strstr(line, "\"test_thread\"") || sscanf(strstr(line, "\"tid\":"), "\"tid\":%u", &tid) != 1) continue;
+        if (nbThreadZones++ && tid != threadId) sameThread = false;
+        threadId = tid;
+    }
+    fclose(file);
+    remove(path);
+    CHECK(nbThreadZones == 2);
+    CHECK(sameThread);
+}
+
+
+
+int main() {
+    testInputEdges();
+    testInputKeyIndices();
+    testTimeFixedStep();
+    testIdleWake();
+    testCacheAssetIsCurrent();
+    testCacheEviction();
+    testProfileFrameSummary();
+    testProfileThreadRelease();
+
+    printf("[EasyWIN32] %u checks, %u failures\n", NB_CHECKS, NB_FAILURES);
+    return NB_FAILURES != 0;
+}